@@ -0,0 +1,48 @@
+'use strict';
+const common = require('../common.js');
+const { AsyncLocalStorage } = require('async_hooks');
+
+// Measures the cost of carrying a store through asynchronous operations.
+const bench = common.createBenchmark(main, {
+  storage: ['enabled', 'disabled'],
+  method: ['await', 'nextTick', 'setImmediate'],
+  n: [1e6]
+});
+
+const methods = {
+  async await(n, done) {
+    for (let i = 0; i < n; i++)
+      await null;
+    done();
+  },
+  nextTick(n, done) {
+    let i = 0;
+    (function next() {
+      if (++i === n) return done();
+      process.nextTick(next);
+    })();
+  },
+  setImmediate(n, done) {
+    let i = 0;
+    (function next() {
+      if (++i === n) return done();
+      setImmediate(next);
+    })();
+  },
+};
+
+function main({ storage, method, n }) {
+  const als = new AsyncLocalStorage();
+  const store = {};
+  const fn = methods[method];
+  const done = () => {
+    if (storage === 'enabled' && als.getStore() !== store)
+      throw new Error('store was not propagated');
+    bench.end(n);
+  };
+  bench.start();
+  if (storage === 'enabled')
+    als.run(store, fn, n, done);
+  else
+    fn(n, done);
+}
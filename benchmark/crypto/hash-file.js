@@ -0,0 +1,62 @@
+// Hashes a set of files, either by piping read streams into Hash objects or
+// with crypto.hashFile().
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+
+const bench = common.createBenchmark(main, {
+  api: ['stream', 'hashFile', 'hashFile-mmap'],
+  algo: ['sha256'],
+  files: [1, 16],
+  len: [64 * 1024, 16 * 1024 * 1024],
+  n: [8]
+});
+
+function streamHash(algo, filename, callback) {
+  const hash = crypto.createHash(algo);
+  fs.createReadStream(filename)
+    .on('error', callback)
+    .pipe(hash)
+    .on('finish', () => callback(null, hash.read()));
+}
+
+function hashStreams(algo, filenames, callback) {
+  let pending = filenames.length;
+  for (const filename of filenames) {
+    streamHash(algo, filename, (err) => {
+      if (err) throw err;
+      if (--pending === 0) callback();
+    });
+  }
+}
+
+function main({ api, algo, files, len, n }) {
+  const filenames = [];
+  const data = Buffer.alloc(len, 'x');
+  for (let i = 0; i < files; i++) {
+    const filename = path.resolve(tmpdir.path,
+                                  `.removeme-benchmark-garbage-${i}`);
+    fs.writeFileSync(filename, data);
+    filenames.push(filename);
+  }
+
+  const options = { mmap: api === 'hashFile-mmap' };
+  let i = 0;
+  bench.start();
+  (function next() {
+    if (i++ === n)
+      return bench.end(n * files);
+    if (api === 'stream')
+      return hashStreams(algo, filenames, next);
+    crypto.hashFile(algo, filenames, options, (err) => {
+      if (err) throw err;
+      next();
+    });
+  })();
+}
@@ -1,5 +1,5 @@
-// Throughput benchmark
-// creates a single hasher, then pushes a bunch of data through it
+// Creation benchmark
+// creates a new hasher for every message, or uses the one-shot APIs
 'use strict';
 const common = require('../common.js');
 const crypto = require('crypto');
@@ -10,7 +10,7 @@ const bench = common.createBenchmark(main, {
   type: ['asc', 'utf', 'buf'],
   out: ['hex', 'binary', 'buffer'],
   len: [2, 1024, 102400, 1024 * 1024],
-  api: ['legacy', 'stream']
+  api: ['legacy', 'stream', 'oneshot', 'batch']
 });
 
 function main({ api, type, len, out, writes, algo }) {
@@ -38,7 +38,12 @@ function main({ api, type, len, out, writes, algo }) {
       throw new Error(`unknown message type: ${type}`);
   }
 
-  const fn = api === 'stream' ? streamWrite : legacyWrite;
+  const fn = {
+    legacy: legacyWrite,
+    stream: streamWrite,
+    oneshot: oneshotWrite,
+    batch: batchWrite
+  }[api];
 
   bench.start();
   fn(algo, message, encoding, writes, len, out);
@@ -80,3 +85,29 @@ function streamWrite(algo, message, encoding, writes, len, outEnc) {
 
   bench.end(gbits);
 }
+
+function oneshotWrite(algo, message, encoding, writes, len, outEnc) {
+  const written = writes * len;
+  const bits = written * 8;
+  const gbits = bits / (1024 * 1024 * 1024);
+
+  // crypto.hash() encodes strings as UTF-8, which is the same as ASCII for
+  // the 'asc' messages.
+  while (writes-- > 0)
+    crypto.hash(algo, message, outEnc);
+
+  bench.end(gbits);
+}
+
+function batchWrite(algo, message, encoding, writes, len, outEnc) {
+  const written = writes * len;
+  const bits = written * 8;
+  const gbits = bits / (1024 * 1024 * 1024);
+
+  const messages = new Array(writes).fill(message);
+  const res = crypto.hashBatch(algo, messages);
+  if (outEnc !== 'buffer')
+    res.toString(outEnc);
+
+  bench.end(gbits);
+}
@@ -0,0 +1,54 @@
+'use strict';
+// Signing and verifying short messages with keys given as PEM strings, which
+// is dominated by the cost of turning the key into an EVP_PKEY.
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures_keydir = path.resolve(__dirname, '../../test/fixtures/keys/');
+
+const keys = {
+  publicKey: fs.readFileSync(`${fixtures_keydir}/rsa_public_2048.pem`, 'ascii'),
+  privateKey: fs.readFileSync(`${fixtures_keydir}/rsa_private_2048.pem`,
+                              'ascii'),
+};
+
+const bench = common.createBenchmark(main, {
+  mode: ['sign', 'verify', 'publicEncrypt'],
+  keyFormat: ['pem', 'keyObject'],
+  n: [1e3]
+});
+
+function main({ mode, keyFormat, n }) {
+  const data = Buffer.from('eyJhbGciOiJSUzI1NiJ9.eyJzdWIiOiIxMjM0NTY3ODkwIn0');
+  let { publicKey, privateKey } = keys;
+  if (keyFormat === 'keyObject') {
+    publicKey = crypto.createPublicKey(publicKey);
+    privateKey = crypto.createPrivateKey(privateKey);
+  }
+  const signature = crypto.sign('sha256', data, privateKey);
+
+  let i;
+  switch (mode) {
+    case 'sign':
+      bench.start();
+      for (i = 0; i < n; i++)
+        crypto.sign('sha256', data, privateKey);
+      bench.end(n);
+      break;
+    case 'verify':
+      bench.start();
+      for (i = 0; i < n; i++)
+        crypto.verify('sha256', data, publicKey, signature);
+      bench.end(n);
+      break;
+    case 'publicEncrypt':
+      bench.start();
+      for (i = 0; i < n; i++)
+        crypto.publicEncrypt(publicKey, data);
+      bench.end(n);
+      break;
+    default:
+      throw new Error(`Unsupported mode ${mode}`);
+  }
+}
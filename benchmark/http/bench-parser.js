@@ -4,12 +4,15 @@ const common = require('../common');
 
 const bench = common.createBenchmark(main, {
   len: [4, 8, 16, 32],
+  // `headers` adds `len` short header lines, `cookie` adds a Cookie header with
+  // `len` cookies and `url` adds `len` path segments and query parameters.
+  type: ['headers', 'cookie', 'url'],
   n: [1e5]
 }, {
   flags: ['--expose-internals', '--no-warnings']
 });
 
-function main({ len, n }) {
+function main({ len, type, n }) {
   const { HTTPParser } = common.binding('http_parser');
   const REQUEST = HTTPParser.REQUEST;
   const kOnHeaders = HTTPParser.kOnHeaders | 0;
@@ -43,10 +46,32 @@ function main({ len, n }) {
     return parser;
   }
 
-  let header = `GET /hello HTTP/1.1${CRLF}Content-Type: text/plain${CRLF}`;
+  function randomString() {
+    return Math.random().toString(36).substr(2);
+  }
+
+  let url = '/hello';
+  if (type === 'url') {
+    const params = [];
+    for (let i = 0; i < len; i++) {
+      url += `/${randomString()}`;
+      params.push(`param${i}=${randomString()}`);
+    }
+    url += `?${params.join('&')}`;
+  }
 
-  for (let i = 0; i < len; i++) {
-    header += `X-Filler${i}: ${Math.random().toString(36).substr(2)}${CRLF}`;
+  let header = `GET ${url} HTTP/1.1${CRLF}Content-Type: text/plain${CRLF}`;
+
+  if (type === 'headers') {
+    for (let i = 0; i < len; i++) {
+      header += `X-Filler${i}: ${randomString()}${CRLF}`;
+    }
+  } else if (type === 'cookie') {
+    const cookies = [];
+    for (let i = 0; i < len; i++) {
+      cookies.push(`cookie${i}=${randomString()}${randomString()}`);
+    }
+    header += `Cookie: ${cookies.join('; ')}${CRLF}`;
   }
   header += CRLF;
 
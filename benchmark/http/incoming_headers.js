@@ -6,16 +6,24 @@ const bench = common.createBenchmark(main, {
   connections: [50], // Concurrent connections
   headers: [20], // Number of header lines to append after the common headers
   w: [0, 6], // Amount of trailing whitespace
+  lazy: [0, 1], // Whether the server uses the `lazyHeaders` option
+  read: ['none', 'few', 'all'], // How many headers the handler reads
   duration: 5
 });
 
-function main({ connections, headers, w, duration }) {
-  const server = http.createServer((req, res) => {
+function main({ connections, headers, w, lazy, read, duration }) {
+  const server = http.createServer({ lazyHeaders: lazy === 1 }, (req, res) => {
+    if (read === 'few') {
+      req.getHeader('content-type');
+      req.getHeader('accept');
+    } else if (read === 'all') {
+      req.headers; // eslint-disable-line no-unused-expressions
+    }
     res.end();
   });
 
   server.listen(common.PORT, () => {
-    const headers = {
+    const requestHeaders = {
       'Content-Type': 'text/plain',
       'Accept': 'text/plain',
       'User-Agent': 'nodejs-benchmark',
@@ -28,12 +36,13 @@ function main({ connections, headers, w, duration }) {
       // - wrk can only send trailing OWS. This is a side-effect of wrk
       // processing requests with http-parser before sending them, causing
       // leading OWS to be stripped.
-      headers[`foo${i}`] = `some header value ${i}${' \t'.repeat(w / 2)}`;
+      requestHeaders[`foo${i}`] =
+        `some header value ${i}${' \t'.repeat(w / 2)}`;
     }
     bench.http({
       path: '/',
       connections,
-      headers,
+      headers: requestHeaders,
       duration
     }, () => {
       server.close();
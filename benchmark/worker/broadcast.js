@@ -0,0 +1,44 @@
+'use strict';
+
+const common = require('../common.js');
+const {
+  MessageChannel,
+  broadcastMessage,
+  receiveMessageOnPort,
+} = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  method: ['broadcastMessage', 'postMessage'],
+  ports: [8, 64],
+  entries: [10, 1000],
+  n: [1e3]
+});
+
+function main({ method, ports, entries, n }) {
+  const payload = {};
+  for (let i = 0; i < entries; i++)
+    payload[`key${i}`] = { value: i, name: `entry ${i}` };
+
+  const channels = [];
+  for (let i = 0; i < ports; i++)
+    channels.push(new MessageChannel());
+  const senders = channels.map(({ port1 }) => port1);
+
+  // The receiving side is the same for both methods, since every port has to
+  // deserialize its own copy of the message either way.
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    if (method === 'broadcastMessage') {
+      broadcastMessage(senders, payload);
+    } else {
+      for (const port of senders)
+        port.postMessage(payload);
+    }
+    for (const { port2 } of channels)
+      receiveMessageOnPort(port2);
+  }
+  bench.end(n);
+
+  for (const { port1 } of channels)
+    port1.close();
+}
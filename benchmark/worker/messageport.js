@@ -3,7 +3,7 @@
 const common = require('../common.js');
 const { MessageChannel } = require('worker_threads');
 const bench = common.createBenchmark(main, {
-  payload: ['string', 'object'],
+  payload: ['string', 'object', 'number', 'uint8array', 'arraybuffer'],
   style: ['eventtarget', 'eventemitter'],
   n: [1e6]
 });
@@ -11,6 +11,7 @@ const bench = common.createBenchmark(main, {
 function main(conf) {
   const n = conf.n;
   let payload;
+  let transfer = false;
 
   switch (conf.payload) {
     case 'string':
@@ -19,6 +20,16 @@ function main(conf) {
     case 'object':
       payload = { action: 'pewpewpew', powerLevel: 9001 };
       break;
+    case 'number':
+      payload = 9001;
+      break;
+    case 'uint8array':
+      payload = new Uint8Array(1024);
+      break;
+    case 'arraybuffer':
+      // A new ArrayBuffer is transferred for every message.
+      transfer = true;
+      break;
     default:
       throw new Error('Unsupported payload type');
   }
@@ -50,6 +61,11 @@ function main(conf) {
   write();
 
   function write() {
-    port1.postMessage(payload);
+    if (transfer) {
+      const ab = new ArrayBuffer(1024);
+      port1.postMessage(ab, [ab]);
+    } else {
+      port1.postMessage(payload);
+    }
   }
 }
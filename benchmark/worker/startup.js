@@ -0,0 +1,29 @@
+'use strict';
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  nodeSnapshot: ['true', 'false'],
+  n: [30]
+});
+
+function main({ n, nodeSnapshot }) {
+  const execArgv = nodeSnapshot === 'true' ? [] : ['--no-node-snapshot'];
+  let started = 0;
+
+  // Start the Workers one after another, so that only the startup time of a
+  // single Worker is measured at any time.
+  function next() {
+    if (started++ === n) {
+      bench.end(n);
+      return;
+    }
+    const worker = new Worker('', { eval: true, execArgv });
+    worker.on('online', () => worker.terminate());
+    worker.on('exit', next);
+  }
+
+  bench.start();
+  next();
+}
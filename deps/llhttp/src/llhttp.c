@@ -1,3 +1,189 @@
+/* Node.js: vectorized span scanning.
+ *
+ * The generated states below advance one byte per iteration through header
+ * values and URLs. `llhttp__span()` lets them skip over runs of bytes that
+ * keep the parser in the same state, 16 or 32 bytes at a time, and returns
+ * the first byte that needs to be looked at by the state itself. Which bytes
+ * are skipped is described by `flags`, plus up to two characters to stop at.
+ * To keep the error behavior identical, only bytes for which the state would
+ * do `p++` and stay in place are skipped, and at least one byte is always
+ * left for the state to consume. Keep this when updating llhttp.
+ */
+
+#include <stdint.h>
+
+#if defined(__AVX2__)
+ #include <immintrin.h>
+ #define LLHTTP__SPAN_AVX2 1
+#endif  /* __AVX2__ */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define LLHTTP__SPAN_SSE2 1
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__GNUC__)
+ #include <arm_neon.h>
+ #define LLHTTP__SPAN_NEON 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+ #include <intrin.h>
+#endif  /* _MSC_VER */
+
+/* Control characters and DEL stop the span. */
+#define LLHTTP__SPAN_CTL 0x1
+/* HTAB does not stop the span, even with LLHTTP__SPAN_CTL. */
+#define LLHTTP__SPAN_TAB 0x2
+/* Form feed does not stop the span, even with LLHTTP__SPAN_CTL. */
+#define LLHTTP__SPAN_FF 0x4
+/* Space stops the span. */
+#define LLHTTP__SPAN_SP 0x8
+/* Bytes >= 0x80 stop the span. */
+#define LLHTTP__SPAN_HIGH 0x10
+
+#define LLHTTP__SPAN_URL \
+    (LLHTTP__SPAN_CTL | LLHTTP__SPAN_SP | LLHTTP__SPAN_TAB | LLHTTP__SPAN_FF)
+#define LLHTTP__SPAN_URL_STRICT \
+    (LLHTTP__SPAN_CTL | LLHTTP__SPAN_SP | LLHTTP__SPAN_HIGH)
+
+#if defined(LLHTTP__SPAN_SSE2) || defined(LLHTTP__SPAN_AVX2) || \
+    defined(LLHTTP__SPAN_NEON)
+static inline unsigned llhttp__span_ctz(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+#if defined(_M_X64) || defined(_M_ARM64)
+  _BitScanForward64(&index, mask);
+#else
+  if ((uint32_t) mask != 0)
+    _BitScanForward(&index, (uint32_t) mask);
+  else
+    _BitScanForward(&index, (uint32_t) (mask >> 32)), index += 32;
+#endif
+  return (unsigned) index;
+#else
+  return (unsigned) __builtin_ctzll(mask);
+#endif
+}
+#endif
+
+#if defined(LLHTTP__SPAN_SSE2)
+static inline __m128i llhttp__span_stops_128(__m128i x, int flags,
+                                             char stop1, char stop2) {
+  __m128i stops = _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(stop1)),
+                               _mm_cmpeq_epi8(x, _mm_set1_epi8(stop2)));
+  if (flags & LLHTTP__SPAN_CTL) {
+    const char max = (flags & LLHTTP__SPAN_SP) ? 0x20 : 0x1f;
+    /* x <= max, as unsigned bytes */
+    __m128i ctl = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(max)), x);
+    if (flags & LLHTTP__SPAN_TAB)
+      ctl = _mm_andnot_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(0x9)), ctl);
+    if (flags & LLHTTP__SPAN_FF)
+      ctl = _mm_andnot_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(0xc)), ctl);
+    stops = _mm_or_si128(stops, ctl);
+    stops = _mm_or_si128(stops, _mm_cmpeq_epi8(x, _mm_set1_epi8(0x7f)));
+  }
+  if (flags & LLHTTP__SPAN_HIGH) {
+    /* The sign bit is set for bytes >= 0x80 */
+    stops = _mm_or_si128(stops, _mm_cmplt_epi8(x, _mm_setzero_si128()));
+  }
+  return stops;
+}
+#endif  /* LLHTTP__SPAN_SSE2 */
+
+#if defined(LLHTTP__SPAN_AVX2)
+static inline __m256i llhttp__span_stops_256(__m256i x, int flags,
+                                             char stop1, char stop2) {
+  __m256i stops =
+      _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(stop1)),
+                      _mm256_cmpeq_epi8(x, _mm256_set1_epi8(stop2)));
+  if (flags & LLHTTP__SPAN_CTL) {
+    const char max = (flags & LLHTTP__SPAN_SP) ? 0x20 : 0x1f;
+    __m256i ctl =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(max)), x);
+    if (flags & LLHTTP__SPAN_TAB) {
+      ctl = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(0x9)),
+                                ctl);
+    }
+    if (flags & LLHTTP__SPAN_FF) {
+      ctl = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(0xc)),
+                                ctl);
+    }
+    stops = _mm256_or_si256(stops, ctl);
+    stops = _mm256_or_si256(stops,
+                            _mm256_cmpeq_epi8(x, _mm256_set1_epi8(0x7f)));
+  }
+  if (flags & LLHTTP__SPAN_HIGH) {
+    stops = _mm256_or_si256(stops,
+                            _mm256_cmpgt_epi8(_mm256_setzero_si256(), x));
+  }
+  return stops;
+}
+#endif  /* LLHTTP__SPAN_AVX2 */
+
+#if defined(LLHTTP__SPAN_NEON)
+static inline uint8x16_t llhttp__span_stops_neon(uint8x16_t x, int flags,
+                                                 char stop1, char stop2) {
+  uint8x16_t stops = vorrq_u8(vceqq_u8(x, vdupq_n_u8((uint8_t) stop1)),
+                              vceqq_u8(x, vdupq_n_u8((uint8_t) stop2)));
+  if (flags & LLHTTP__SPAN_CTL) {
+    const uint8_t max = (flags & LLHTTP__SPAN_SP) ? 0x20 : 0x1f;
+    uint8x16_t ctl = vcleq_u8(x, vdupq_n_u8(max));
+    if (flags & LLHTTP__SPAN_TAB)
+      ctl = vbicq_u8(ctl, vceqq_u8(x, vdupq_n_u8(0x9)));
+    if (flags & LLHTTP__SPAN_FF)
+      ctl = vbicq_u8(ctl, vceqq_u8(x, vdupq_n_u8(0xc)));
+    stops = vorrq_u8(stops, ctl);
+    stops = vorrq_u8(stops, vceqq_u8(x, vdupq_n_u8(0x7f)));
+  }
+  if (flags & LLHTTP__SPAN_HIGH)
+    stops = vorrq_u8(stops, vcgeq_u8(x, vdupq_n_u8(0x80)));
+  return stops;
+}
+#endif  /* LLHTTP__SPAN_NEON */
+
+static inline const unsigned char* llhttp__span(const unsigned char* p,
+                                                const unsigned char* endp,
+                                                int flags,
+                                                char stop1,
+                                                char stop2) {
+#if defined(LLHTTP__SPAN_AVX2)
+  while (endp - p > 32) {
+    __m256i x = _mm256_loadu_si256((__m256i const*) p);
+    uint32_t mask = (uint32_t) _mm256_movemask_epi8(
+        llhttp__span_stops_256(x, flags, stop1, stop2));
+    if (mask != 0)
+      return p + llhttp__span_ctz(mask);
+    p += 32;
+  }
+#endif  /* LLHTTP__SPAN_AVX2 */
+#if defined(LLHTTP__SPAN_SSE2)
+  while (endp - p > 16) {
+    __m128i x = _mm_loadu_si128((__m128i const*) p);
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(
+        llhttp__span_stops_128(x, flags, stop1, stop2));
+    if (mask != 0)
+      return p + llhttp__span_ctz(mask);
+    p += 16;
+  }
+#elif defined(LLHTTP__SPAN_NEON)
+  while (endp - p > 16) {
+    uint8x16_t stops =
+        llhttp__span_stops_neon(vld1q_u8(p), flags, stop1, stop2);
+    /* Narrow to 4 bits per byte to get a mask that fits into 64 bits */
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(
+        vshrn_n_u16(vreinterpretq_u16_u8(stops), 4)), 0);
+    if (mask != 0)
+      return p + (llhttp__span_ctz(mask) >> 2);
+    p += 16;
+  }
+#else
+  (void) endp;
+  (void) flags;
+  (void) stop1;
+  (void) stop2;
+#endif
+  return p;
+}
+
 #if LLHTTP_STRICT_MODE
 
 #include <stdlib.h>
@@ -1601,6 +1787,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_header_value_lenient;
       }
+      p = llhttp__span(p, endp, 0, '\r', '\n');
       switch (*p) {
         case 10: {
           goto s_n_llhttp__internal__n_span_end_llhttp__on_header_value_1;
@@ -1979,6 +2166,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_header_value;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_CTL | LLHTTP__SPAN_TAB, 0, 0);
       #ifdef __SSE4_2__
       if (endp - p >= 16) {
         __m128i ranges;
@@ -2859,6 +3047,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_url_fragment;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_URL_STRICT, 0, 0);
       switch (lookup_table[(uint8_t) *p]) {
         case 1: {
           p++;
@@ -2917,6 +3106,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_url_query;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_URL_STRICT, '#', '#');
       switch (lookup_table[(uint8_t) *p]) {
         case 1: {
           p++;
@@ -3006,6 +3196,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_url_path;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_URL_STRICT, '#', '?');
       switch (lookup_table[(uint8_t) *p]) {
         case 1: {
           p++;
@@ -8466,6 +8657,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_header_value_lenient;
       }
+      p = llhttp__span(p, endp, 0, '\r', '\n');
       switch (*p) {
         case 10: {
           goto s_n_llhttp__internal__n_span_end_llhttp__on_header_value_1;
@@ -8844,6 +9036,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_header_value;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_CTL | LLHTTP__SPAN_TAB, 0, 0);
       #ifdef __SSE4_2__
       if (endp - p >= 16) {
         __m128i ranges;
@@ -9640,6 +9833,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_url_fragment;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_URL, 0, 0);
       switch (lookup_table[(uint8_t) *p]) {
         case 1: {
           p++;
@@ -9694,6 +9888,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_url_query;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_URL, '#', '#');
       switch (lookup_table[(uint8_t) *p]) {
         case 1: {
           p++;
@@ -9771,6 +9966,7 @@ static llparse_state_t llhttp__internal__run(
       if (p == endp) {
         return s_n_llhttp__internal__n_url_path;
       }
+      p = llhttp__span(p, endp, LLHTTP__SPAN_URL, '#', '?');
       #ifdef __SSE4_2__
       if (endp - p >= 16) {
         __m128i ranges;
@@ -27,16 +27,22 @@ const {
 } = primordials;
 const { setImmediate } = require('timers');
 
-const { methods, HTTPParser } = internalBinding('http_parser');
+const {
+  methods,
+  headerNameIds,
+  HTTPParser
+} = internalBinding('http_parser');
 const { getOptionValue } = require('internal/options');
 const insecureHTTPParser = getOptionValue('--insecure-http-parser');
 
 const FreeList = require('internal/freelist');
+const { isArrayBuffer } = require('internal/util/types');
 const incoming = require('_http_incoming');
 const {
   IncomingMessage,
   readStart,
-  readStop
+  readStop,
+  setHeaderBlock,
 } = incoming;
 
 let debug = require('internal/util/debuglog').debuglog('http', (fn) => {
@@ -52,6 +58,8 @@ const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
 const kOnTimeout = HTTPParser.kOnTimeout | 0;
+const kOnEvents = HTTPParser.kOnEvents | 0;
+const kOnKeepAliveTimeout = HTTPParser.kOnKeepAliveTimeout | 0;
 
 const MAX_HEADER_PAIRS = 2000;
 
@@ -75,13 +83,18 @@ function parserOnHeaders(headers, url) {
 // all our parsers are request parsers.
 function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
                                  url, statusCode, statusMessage, upgrade,
-                                 shouldKeepAlive) {
+                                 shouldKeepAlive, batched) {
   const parser = this;
   const { socket } = parser;
 
+  // The ids of the header names are only available when the headers were
+  // passed in directly. They are overwritten by the next message, so batched
+  // events come without them.
+  let ids = batched ? undefined : headerNameIds;
   if (headers === undefined) {
     headers = parser._headers;
     parser._headers = [];
+    ids = undefined;
   }
 
   if (url === undefined) {
@@ -107,13 +120,18 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
     incoming.socket[kRequestTimeout] = undefined;
   }
 
-  let n = headers.length;
+  if (isArrayBuffer(headers)) {
+    // Lazy headers mode, the header strings are created on first access.
+    setHeaderBlock(incoming, headers, parser.maxHeaderPairs);
+  } else {
+    let n = headers.length;
 
-  // If parser.maxHeaderPairs <= 0 assume that there's no limit.
-  if (parser.maxHeaderPairs > 0)
-    n = MathMin(n, parser.maxHeaderPairs);
+    // If parser.maxHeaderPairs <= 0 assume that there's no limit.
+    if (parser.maxHeaderPairs > 0)
+      n = MathMin(n, parser.maxHeaderPairs);
 
-  incoming._addHeaderLines(headers, n);
+    incoming._addHeaderLines(headers, n, ids);
+  }
 
   if (typeof method === 'number') {
     // server only
@@ -165,6 +183,47 @@ function parserOnMessageComplete() {
   readStart(parser.socket);
 }
 
+// Used instead of the individual callbacks above when the parser batches the
+// events of each read of a consumed socket. `events` holds `length` entries,
+// each event index being followed by the arguments of its callback.
+function parserOnEvents(events, length) {
+  const parser = this;
+  let i = 0;
+  while (i < length) {
+    const event = events[i++];
+    switch (event) {
+      case kOnHeaders:
+        parser[kOnHeaders](events[i], events[i + 1]);
+        i += 2;
+        break;
+      case kOnHeadersComplete:
+        parser[kOnHeadersComplete](events[i], events[i + 1], events[i + 2],
+                                   events[i + 3], events[i + 4], events[i + 5],
+                                   events[i + 6], events[i + 7], events[i + 8],
+                                   true);
+        i += 9;
+        break;
+      case kOnBody:
+        parser[kOnBody](events[i], events[i + 1], events[i + 2]);
+        i += 3;
+        break;
+      case kOnMessageComplete:
+        parser[kOnMessageComplete]();
+        break;
+      case kOnExecute:
+        // The parser may have been freed by one of the earlier events.
+        if (typeof parser[kOnExecute] === 'function')
+          parser[kOnExecute](events[i]);
+        i += 1;
+        break;
+      default:
+        // kOnMessageBegin and kOnTimeout.
+        if (typeof parser[event] === 'function')
+          parser[event]();
+    }
+  }
+}
+
 
 const parsers = new FreeList('parsers', 1000, function parsersCb() {
   const parser = new HTTPParser();
@@ -242,6 +301,8 @@ function cleanParser(parser) {
   parser[kOnMessageBegin] = null;
   parser[kOnExecute] = null;
   parser[kOnTimeout] = null;
+  parser[kOnEvents] = null;
+  parser[kOnKeepAliveTimeout] = null;
   parser._consumed = false;
   parser.onIncoming = null;
 }
@@ -271,6 +332,7 @@ module.exports = {
   debug,
   freeParser,
   methods,
+  parserOnEvents,
   parsers,
   kIncomingMessage,
   kRequestTimeout,
@@ -22,11 +22,26 @@
 'use strict';
 
 const {
+  ArrayPrototypeMap,
+  MathMin,
+  ObjectDefineProperties,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
+  StringPrototypeToLowerCase,
+  Symbol,
 } = primordials;
 
 const Stream = require('stream');
+const {
+  knownHeaderNames,
+  headerNameIds,
+  getHeaderBlockValues,
+  materializeHeaderBlock,
+} = internalBinding('http_parser');
+const { validateString } = require('internal/validators');
+
+const kHeaderBlock = Symbol('kHeaderBlock');
+const kMaxHeaderEntries = Symbol('kMaxHeaderEntries');
 
 function readStart(socket) {
   if (socket && !socket._paused && socket.readable)
@@ -60,6 +75,10 @@ function IncomingMessage(socket) {
   this.complete = false;
   this.headers = {};
   this.rawHeaders = [];
+  // The raw header lines from the HTTP parser in lazy headers mode, until
+  // `headers` or `rawHeaders` is accessed.
+  this[kHeaderBlock] = null;
+  this[kMaxHeaderEntries] = 0;
   this.trailers = {};
   this.rawTrailers = [];
 
@@ -93,6 +112,98 @@ ObjectDefineProperty(IncomingMessage.prototype, 'connection', {
   }
 });
 
+// Only installed on messages in lazy headers mode, so that `headers` and
+// `rawHeaders` remain plain data properties otherwise. The first access
+// replaces them with data properties again.
+const lazyHeaderDescriptors = {
+  headers: {
+    configurable: true,
+    enumerable: true,
+    get: function() {
+      materializeHeaders(this);
+      return this.headers;
+    },
+    set: function(val) {
+      materializeHeaders(this);
+      this.headers = val;
+    }
+  },
+  rawHeaders: {
+    configurable: true,
+    enumerable: true,
+    get: function() {
+      materializeHeaders(this);
+      return this.rawHeaders;
+    },
+    set: function(val) {
+      materializeHeaders(this);
+      this.rawHeaders = val;
+    }
+  }
+};
+
+// Stores a header block from the HTTP parser, see HeaderBlock in
+// src/node_http_parser.cc. `maxEntries` limits the number of entries of
+// `rawHeaders` that are turned into `headers`, like in _addHeaderLines().
+function setHeaderBlock(msg, block, maxEntries) {
+  msg[kHeaderBlock] = block;
+  msg[kMaxHeaderEntries] = maxEntries > 0 ? maxEntries : 0;
+  ObjectDefineProperties(msg, lazyHeaderDescriptors);
+}
+
+function materializeHeaders(msg) {
+  const block = msg[kHeaderBlock];
+  msg[kHeaderBlock] = null;
+  const headers = {};
+  // The plain properties are in place before the block is read, so that the
+  // message is left without headers rather than in lazy mode if that throws.
+  ObjectDefineProperties(msg, {
+    headers: {
+      configurable: true,
+      enumerable: true,
+      writable: true,
+      value: headers
+    },
+    rawHeaders: {
+      configurable: true,
+      enumerable: true,
+      writable: true,
+      value: []
+    }
+  });
+  // This also fills in headerNameIds for the returned headers.
+  const rawHeaders = materializeHeaderBlock(block);
+  let n = rawHeaders.length;
+  if (msg[kMaxHeaderEntries] > 0)
+    n = MathMin(n, msg[kMaxHeaderEntries]);
+  msg.rawHeaders = rawHeaders;
+  addHeaderLines(msg, rawHeaders, n, headerNameIds, headers);
+}
+
+// Returns what `msg.headers[name]` would be for the lowercase `name`. In lazy
+// headers mode, only the lines with that name are turned into strings.
+function lookupHeader(msg, name) {
+  const block = msg[kHeaderBlock];
+  // `msg` may also be a user-provided object, e.g. for a ServerResponse.
+  if (!block)
+    return msg.headers[name];
+
+  const values = getHeaderBlockValues(block, name, msg[kMaxHeaderEntries]);
+  if (values.length === 0)
+    return undefined;
+  const dest = {};
+  for (let i = 0; i < values.length; i++)
+    msg._addHeaderLine(name, values[i], dest);
+  return dest[name];
+}
+
+// In lazy headers mode, this only creates the strings of the requested
+// header, and does not build the full `headers` object.
+IncomingMessage.prototype.getHeader = function getHeader(name) {
+  validateString(name, 'name');
+  return lookupHeader(this, StringPrototypeToLowerCase(name));
+};
+
 IncomingMessage.prototype.setTimeout = function setTimeout(msecs, callback) {
   if (callback)
     this.on('timeout', callback);
@@ -132,8 +243,11 @@ IncomingMessage.prototype.destroy = function destroy(error) {
 };
 
 
+// `ids` optionally holds the id of each header name as reported by the HTTP
+// parser, where a non-zero id means that the name is a well-known one whose
+// matchKnownFields() result is already known.
 IncomingMessage.prototype._addHeaderLines = _addHeaderLines;
-function _addHeaderLines(headers, n) {
+function _addHeaderLines(headers, n, ids) {
   if (headers && headers.length) {
     let dest;
     if (this.complete) {
@@ -144,9 +258,17 @@ function _addHeaderLines(headers, n) {
       dest = this.headers;
     }
 
-    for (let i = 0; i < n; i += 2) {
-      this._addHeaderLine(headers[i], headers[i + 1], dest);
-    }
+    addHeaderLines(this, headers, n, ids, dest);
+  }
+}
+
+function addHeaderLines(msg, headers, n, ids, dest) {
+  for (let i = 0; i < n; i += 2) {
+    const id = ids !== undefined ? ids[i >> 1] : 0;
+    if (id !== 0)
+      addHeaderLine(knownHeaderFields[id - 1], headers[i + 1], dest);
+    else
+      msg._addHeaderLine(headers[i], headers[i + 1], dest);
   }
 }
 
@@ -268,7 +390,16 @@ function matchKnownFields(field, lowercased) {
 // 'x-') are always joined.
 IncomingMessage.prototype._addHeaderLine = _addHeaderLine;
 function _addHeaderLine(field, value, dest) {
-  field = matchKnownFields(field);
+  addHeaderLine(matchKnownFields(field), value, dest);
+}
+
+// Index `id - 1` holds matchKnownFields() of the header name with that id,
+// see `headerNameIds` in src/node_http_parser.cc.
+const knownHeaderFields = ArrayPrototypeMap(
+  knownHeaderNames, (name) => matchKnownFields(name, true));
+
+// `field` is the result of matchKnownFields().
+function addHeaderLine(field, value, dest) {
   const flag = field.charCodeAt(0);
   if (flag === 0 || flag === 2) {
     field = field.slice(1);
@@ -306,6 +437,8 @@ IncomingMessage.prototype._dump = function _dump() {
 
 module.exports = {
   IncomingMessage,
+  lookupHeader,
   readStart,
-  readStop
+  readStop,
+  setHeaderBlock,
 };
@@ -24,6 +24,7 @@
 const {
   Array,
   ArrayIsArray,
+  ArrayPrototypePush,
   ObjectCreate,
   ObjectDefineProperty,
   ObjectKeys,
@@ -39,11 +40,15 @@ const assert = require('internal/assert');
 const EE = require('events');
 const Stream = require('stream');
 const internalUtil = require('internal/util');
-const { kOutHeaders, utcDate, kNeedDrain } = require('internal/http');
+const { kOutHeaders, kNeedDrain } = require('internal/http');
 const { Buffer } = require('buffer');
 const common = require('_http_common');
 const checkIsHttpToken = common._checkIsHttpToken;
 const checkInvalidHeaderChar = common._checkInvalidHeaderChar;
+const {
+  outgoingHeaderState,
+  serializeHeaders,
+} = internalBinding('http_parser');
 const {
   defaultTriggerAsyncIdScope,
   symbols: { async_id_symbol }
@@ -72,8 +77,17 @@ const { CRLF, debug } = common;
 
 const kCorked = Symbol('corked');
 
-const RE_CONN_CLOSE = /(?:^|\W)close(?:$|\W)/i;
-const RE_TE_CHUNKED = common.chunkExpression;
+// Indices into `outgoingHeaderState`. Keep in sync with
+// OutgoingHeaderStateFields in src/node_http_parser.cc.
+const kHasConnection = 0;
+const kConnectionClose = 1;
+const kConnectionKeepAlive = 2;
+const kHasContentLength = 3;
+const kHasTransferEncoding = 4;
+const kChunked = 5;
+const kHasExpect = 7;
+const kHasTrailer = 8;
+const kHasKeepAlive = 9;
 
 // isCookieField performs a case-insensitive comparison of a provided string
 // against the word "cookie." As of V8 6.6 this is faster than handrolling or
@@ -362,27 +376,21 @@ OutgoingMessage.prototype._storeHeader = _storeHeader;
 function _storeHeader(firstLine, headers) {
   // firstLine in the case of request is: 'GET /index.html HTTP/1.1\r\n'
   // in the case of response it is: 'HTTP/1.1 200 OK\r\n'
-  const state = {
-    connection: false,
-    contLen: false,
-    te: false,
-    date: false,
-    expect: false,
-    trailer: false,
-    header: firstLine
-  };
+  const lines = [];
+  let validate = true;
 
   if (headers) {
     if (headers === this[kOutHeaders]) {
+      validate = false;
       for (const key in headers) {
         const entry = headers[key];
-        processHeader(this, state, entry[0], entry[1], false);
+        processHeader(lines, entry[0], entry[1], false);
       }
     } else if (ArrayIsArray(headers)) {
       if (headers.length && ArrayIsArray(headers[0])) {
         for (let i = 0; i < headers.length; i++) {
           const entry = headers[i];
-          processHeader(this, state, entry[0], entry[1], true);
+          processHeader(lines, entry[0], entry[1], true);
         }
       } else {
         if (headers.length % 2 !== 0) {
@@ -390,24 +398,34 @@ function _storeHeader(firstLine, headers) {
         }
 
         for (let n = 0; n < headers.length; n += 2) {
-          processHeader(this, state, headers[n + 0], headers[n + 1], true);
+          processHeader(lines, headers[n + 0], headers[n + 1], true);
         }
       }
     } else {
       for (const key in headers) {
         if (ObjectPrototypeHasOwnProperty(headers, key)) {
-          processHeader(this, state, key, headers[key], true);
+          processHeader(lines, key, headers[key], true);
         }
       }
     }
   }
 
-  let { header } = state;
-
-  // Date header
-  if (this.sendDate && !state.date) {
-    header += 'Date: ' + utcDate() + CRLF;
+  // The header lines, including the Date header unless one was given, are
+  // validated and put together in C++.
+  const lineHeader = serializeHeaders(lines, validate, this.sendDate);
+  if (typeof lineHeader === 'number') {
+    // Throw the error for the invalid pair.
+    const name = lines[lineHeader];
+    validateHeaderName(name);
+    validateHeaderValue(name, lines[lineHeader + 1]);
+    // The pair was rejected natively, so it must not be sent even if the
+    // checks above did not agree.
+    throw new ERR_INVALID_CHAR('header content', name);
   }
+  const state = outgoingHeaderState;
+  matchHeaders(this, state);
+
+  let header = firstLine + lineHeader;
 
   // Force the connection to close when the response is a 204 No Content or
   // a 304 Not Modified and the user has set a "Transfer-Encoding: chunked"
@@ -432,9 +450,10 @@ function _storeHeader(firstLine, headers) {
   if (this._removedConnection) {
     this._last = true;
     this.shouldKeepAlive = false;
-  } else if (!state.connection) {
+  } else if (!state[kHasConnection]) {
     const shouldSendKeepAlive = this.shouldKeepAlive &&
-        (state.contLen || this.useChunkedEncodingByDefault || this.agent);
+        (state[kHasContentLength] || this.useChunkedEncodingByDefault ||
+         this.agent);
     if (shouldSendKeepAlive) {
       header += 'Connection: keep-alive\r\n';
       if (this._keepAliveTimeout && this._defaultKeepAlive) {
@@ -447,13 +466,13 @@ function _storeHeader(firstLine, headers) {
     }
   }
 
-  if (!state.contLen && !state.te) {
+  if (!state[kHasContentLength] && !state[kHasTransferEncoding]) {
     if (!this._hasBody) {
       // Make sure we don't end the 0\r\n\r\n at the end of the message.
       this.chunkedEncoding = false;
     } else if (!this.useChunkedEncodingByDefault) {
       this._last = true;
-    } else if (!state.trailer &&
+    } else if (!state[kHasTrailer] &&
                !this._removedContLen &&
                typeof this._contentLength === 'number') {
       header += 'Content-Length: ' + this._contentLength + CRLF;
@@ -472,7 +491,7 @@ function _storeHeader(firstLine, headers) {
   // message will be terminated by the first empty line after the
   // header fields, regardless of the header fields present in the
   // message, and thus cannot contain a message body or 'trailers'.
-  if (this.chunkedEncoding !== true && state.trailer) {
+  if (this.chunkedEncoding !== true && state[kHasTrailer]) {
     throw new ERR_HTTP_TRAILER_INVALID();
   }
 
@@ -481,63 +500,46 @@ function _storeHeader(firstLine, headers) {
 
   // Wait until the first body chunk, or close(), is sent to flush,
   // UNLESS we're sending Expect: 100-continue.
-  if (state.expect) this._send('');
+  if (state[kHasExpect]) this._send('');
 }
 
-function processHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderName(key);
+// Appends the name and value pairs for a header to `lines`.
+function processHeader(lines, key, value, validate) {
   if (ArrayIsArray(value)) {
     if (value.length < 2 || !isCookieField(key)) {
+      if (validate && value.length === 0)
+        validateHeaderName(key);
       // Retain for(;;) loop for performance reasons
       // Refs: https://github.com/nodejs/node/pull/30958
       for (let i = 0; i < value.length; i++)
-        storeHeader(self, state, key, value[i], validate);
+        ArrayPrototypePush(lines, key, value[i]);
       return;
     }
+    if (validate)
+      validateHeaderName(key);
     value = value.join('; ');
   }
-  storeHeader(self, state, key, value, validate);
+  ArrayPrototypePush(lines, key, value);
 }
 
-function storeHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderValue(key, value);
-  state.header += key + ': ' + value + CRLF;
-  matchHeader(self, state, key, value);
-}
-
-function matchHeader(self, state, field, value) {
-  if (field.length < 4 || field.length > 17)
-    return;
-  field = field.toLowerCase();
-  switch (field) {
-    case 'connection':
-      state.connection = true;
-      self._removedConnection = false;
-      if (RE_CONN_CLOSE.test(value))
-        self._last = true;
-      else
-        self.shouldKeepAlive = true;
-      break;
-    case 'transfer-encoding':
-      state.te = true;
-      self._removedTE = false;
-      if (RE_TE_CHUNKED.test(value)) self.chunkedEncoding = true;
-      break;
-    case 'content-length':
-      state.contLen = true;
-      self._removedContLen = false;
-      break;
-    case 'date':
-    case 'expect':
-    case 'trailer':
-      state[field] = true;
-      break;
-    case 'keep-alive':
-      self._defaultKeepAlive = false;
-      break;
-  }
+// Applies what serializeHeaders() found out about the special headers.
+function matchHeaders(self, state) {
+  if (state[kHasConnection]) {
+    self._removedConnection = false;
+    if (state[kConnectionClose])
+      self._last = true;
+    if (state[kConnectionKeepAlive])
+      self.shouldKeepAlive = true;
+  }
+  if (state[kHasTransferEncoding]) {
+    self._removedTE = false;
+    if (state[kChunked])
+      self.chunkedEncoding = true;
+  }
+  if (state[kHasContentLength])
+    self._removedContLen = false;
+  if (state[kHasKeepAlive])
+    self._defaultKeepAlive = false;
 }
 
 const validateHeaderName = hideStackFrames((name) => {
@@ -35,6 +35,7 @@ const EE = require('events');
 const assert = require('internal/assert');
 const {
   parsers,
+  parserOnEvents,
   freeParser,
   debug,
   CRLF,
@@ -57,7 +58,7 @@ const {
   defaultTriggerAsyncIdScope,
   getOrSetAsyncId
 } = require('internal/async_hooks');
-const { IncomingMessage } = require('_http_incoming');
+const { IncomingMessage, lookupHeader } = require('_http_incoming');
 const {
   ERR_HTTP_REQUEST_TIMEOUT,
   ERR_HTTP_HEADERS_SENT,
@@ -155,6 +156,8 @@ const STATUS_CODES = {
 const kOnMessageBegin = HTTPParser.kOnMessageBegin | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
 const kOnTimeout = HTTPParser.kOnTimeout | 0;
+const kOnEvents = HTTPParser.kOnEvents | 0;
+const kOnKeepAliveTimeout = HTTPParser.kOnKeepAliveTimeout | 0;
 
 class HTTPServerAsyncResource {
   constructor(type, socket) {
@@ -173,7 +176,8 @@ function ServerResponse(req) {
   this._expect_continue = false;
 
   if (req.httpVersionMajor < 1 || req.httpVersionMinor < 1) {
-    this.useChunkedEncodingByDefault = chunkExpression.test(req.headers.te);
+    this.useChunkedEncodingByDefault =
+      chunkExpression.test(lookupHeader(req, 'te'));
     this.shouldKeepAlive = false;
   }
 
@@ -350,6 +354,16 @@ function storeHTTPOptions(options) {
   if (insecureHTTPParser !== undefined)
     validateBoolean(insecureHTTPParser, 'options.insecureHTTPParser');
   this.insecureHTTPParser = insecureHTTPParser;
+
+  const batchParserEvents = options.batchParserEvents;
+  if (batchParserEvents !== undefined)
+    validateBoolean(batchParserEvents, 'options.batchParserEvents');
+  this.batchParserEvents = batchParserEvents;
+
+  const lazyHeaders = options.lazyHeaders;
+  if (lazyHeaders !== undefined)
+    validateBoolean(lazyHeaders, 'options.lazyHeaders');
+  this.lazyHeaders = lazyHeaders;
 }
 
 function Server(options, requestListener) {
@@ -450,6 +464,8 @@ function connectionListenerInternal(server, socket) {
       isLenient() : server.insecureHTTPParser,
     server.headersTimeout || 0,
   );
+  if (server.lazyHeaders)
+    parser.setLazyHeaders(true);
   parser.socket = socket;
   socket.parser = parser;
 
@@ -498,6 +514,8 @@ function connectionListenerInternal(server, socket) {
     parser._consumed = true;
     socket._handle._consumed = true;
     parser.consume(socket._handle);
+    if (server.batchParserEvents)
+      parser[kOnEvents] = parserOnEvents;
   }
   parser[kOnExecute] =
     onParserExecute.bind(undefined, server, socket, parser, state);
@@ -505,6 +523,9 @@ function connectionListenerInternal(server, socket) {
   parser[kOnTimeout] =
     onParserTimeout.bind(undefined, server, socket);
 
+  parser[kOnKeepAliveTimeout] =
+    onParserKeepAliveTimeout.bind(undefined, socket);
+
   // When receiving new requests on the same socket (pipelining or keep alive)
   // make sure the requestTimeout is active.
   parser[kOnMessageBegin] =
@@ -616,6 +637,12 @@ function onParserExecute(server, socket, parser, state, ret) {
   onParserExecuteCommon(server, socket, parser, state, ret, undefined);
 }
 
+// The keep-alive timeout of a consumed socket is tracked by the parser, but
+// is reported the same way as the socket timeout it replaces.
+function onParserKeepAliveTimeout(socket) {
+  socket.emit('timeout');
+}
+
 function onParserTimeout(server, socket) {
   const serverTimeout = server.emit('timeout', socket);
 
@@ -804,7 +831,16 @@ function resOnFinish(req, res, socket, state, server) {
     }
   } else if (state.outgoing.length === 0) {
     if (server.keepAliveTimeout && typeof socket.setTimeout === 'function') {
-      socket.setTimeout(server.keepAliveTimeout);
+      if (socket.parser && socket.parser._consumed) {
+        // The parser tracks the timeout in C++ and cancels it as soon as
+        // more data arrives, which saves arming a JS timer for every idle
+        // connection.
+        if (server.timeout)
+          socket.setTimeout(0);
+        socket.parser.setKeepAliveTimeout(server.keepAliveTimeout);
+      } else {
+        socket.setTimeout(server.keepAliveTimeout);
+      }
       state.keepAliveTimeoutSet = true;
     }
   } else {
@@ -877,9 +913,10 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
   res.on('finish',
          resOnFinish.bind(undefined, req, res, socket, state, server));
 
-  if (req.headers.expect !== undefined &&
+  const expect = lookupHeader(req, 'expect');
+  if (expect !== undefined &&
       (req.httpVersionMajor === 1 && req.httpVersionMinor === 1)) {
-    if (continueExpression.test(req.headers.expect)) {
+    if (continueExpression.test(expect)) {
       res._expect_continue = true;
 
       if (server.listenerCount('checkContinue') > 0) {
@@ -906,7 +943,13 @@ function resetSocketTimeout(server, socket, state) {
   if (!state.keepAliveTimeoutSet)
     return;
 
-  socket.setTimeout(server.timeout || 0);
+  if (socket.parser && socket.parser._consumed) {
+    socket.parser.setKeepAliveTimeout(0);
+    if (server.timeout)
+      socket.setTimeout(server.timeout);
+  } else {
+    socket.setTimeout(server.timeout || 0);
+  }
   state.keepAliveTimeoutSet = false;
 }
 
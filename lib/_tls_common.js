@@ -23,8 +23,10 @@
 
 const {
   ArrayIsArray,
+  Float64Array,
   JSONParse,
   ObjectCreate,
+  Symbol,
 } = primordials;
 
 const { parseCertString } = require('internal/tls');
@@ -36,7 +38,13 @@ const {
   ERR_INVALID_OPT_VALUE,
   ERR_TLS_INVALID_PROTOCOL_VERSION,
   ERR_TLS_PROTOCOL_VERSION_CONFLICT,
+  ERR_TLS_REQUIRED_SERVER_NAME,
 } = require('internal/errors').codes;
+const {
+  validateInteger,
+  validateObject,
+  validateString,
+} = require('internal/validators');
 const {
   SSL_OP_CIPHER_SERVER_PREFERENCE,
   TLS1_VERSION,
@@ -57,7 +65,10 @@ function toV(which, v, def) {
   throw new ERR_TLS_INVALID_PROTOCOL_VERSION(v, which);
 }
 
-const { SecureContext: NativeSecureContext } = internalBinding('crypto');
+const {
+  SecureContext: NativeSecureContext,
+  SNICertStore: NativeSNICertStore,
+} = internalBinding('crypto');
 function SecureContext(secureProtocol, secureOptions, minVersion, maxVersion) {
   if (!(this instanceof SecureContext)) {
     return new SecureContext(secureProtocol, secureOptions, minVersion,
@@ -91,6 +102,62 @@ function validateKeyOrCertOption(name, value) {
 
 exports.SecureContext = SecureContext;
 
+const kHandle = Symbol('kHandle');
+
+// Certificates and keys registered here are only parsed when a ClientHello
+// first names the host, and are selected natively without calling into JS.
+class SNICertStore {
+  constructor(options = {}) {
+    validateObject(options, 'options');
+    const { maxCachedContexts = 1000 } = options;
+    validateInteger(maxCachedContexts, 'options.maxCachedContexts',
+                    1, 2 ** 32 - 1);
+    this[kHandle] = new NativeSNICertStore(maxCachedContexts);
+  }
+
+  add(servername, options) {
+    validateString(servername, 'servername');
+    if (servername === '')
+      throw new ERR_TLS_REQUIRED_SERVER_NAME();
+    validateObject(options, 'options');
+
+    const { cert, key, certFile, keyFile, passphrase } = options;
+    if (passphrase !== undefined)
+      validateString(passphrase, 'options.passphrase');
+
+    if (certFile !== undefined || keyFile !== undefined) {
+      validateString(certFile, 'options.certFile');
+      validateString(keyFile, 'options.keyFile');
+      this[kHandle].add(servername, certFile, keyFile, passphrase, true);
+    } else {
+      validateKeyOrCertOption('cert', cert);
+      validateKeyOrCertOption('key', key);
+      this[kHandle].add(servername, cert, key, passphrase, false);
+    }
+    return this;
+  }
+
+  delete(servername) {
+    validateString(servername, 'servername');
+    return this[kHandle].remove(servername);
+  }
+
+  stats() {
+    const fields = new Float64Array(5);
+    this[kHandle].getStats(fields);
+    return {
+      hits: fields[0],
+      misses: fields[1],
+      evictions: fields[2],
+      loadErrors: fields[3],
+      cachedContexts: fields[4],
+    };
+  }
+}
+
+exports.SNICertStore = SNICertStore;
+exports.kSNICertStoreHandle = kHandle;
+
 
 exports.createSecureContext = function createSecureContext(options) {
   if (!options) options = {};
@@ -90,6 +90,7 @@ const kErrorEmitted = Symbol('error-emitted');
 const kHandshakeTimeout = Symbol('handshake-timeout');
 const kRes = Symbol('res');
 const kSNICallback = Symbol('snicallback');
+const kSNICertStore = Symbol('snicertstore');
 const kEnableTrace = Symbol('enableTrace');
 const kPskCallback = Symbol('pskcallback');
 const kPskIdentityHint = Symbol('pskidentityhint');
@@ -192,7 +193,8 @@ function loadSession(hello) {
 function loadSNI(info) {
   const owner = this[owner_symbol];
   const servername = info.servername;
-  if (!servername || !owner._SNICallback)
+  // The server's SNICertStore already selected a context for this name.
+  if (!servername || !owner._SNICallback || info.SNICertStoreMatch)
     return requestOCSP(owner, info);
 
   let once = false;
@@ -1328,6 +1330,13 @@ Server.prototype.setSecureContext = function(options) {
   this.privateKeyIdentifier = options.privateKeyIdentifier;
   this.privateKeyEngine = options.privateKeyEngine;
 
+  if (options.SNICertStore !== undefined &&
+      !(options.SNICertStore instanceof common.SNICertStore)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'options.SNICertStore', 'tls.SNICertStore', options.SNICertStore);
+  }
+  this[kSNICertStore] = options.SNICertStore;
+
   this._sharedCreds = tls.createSecureContext({
     pfx: this.pfx,
     key: this.key,
@@ -1351,6 +1360,11 @@ Server.prototype.setSecureContext = function(options) {
     privateKeyIdentifier: this.privateKeyIdentifier,
     privateKeyEngine: this.privateKeyEngine,
   });
+
+  if (this[kSNICertStore] !== undefined) {
+    this._sharedCreds.context.setSNICertStore(
+      this[kSNICertStore][common.kSNICertStoreHandle]);
+  }
 };
 
 
@@ -10,6 +10,7 @@ const {
   ObjectDefineProperties,
   ObjectIs,
   ReflectApply,
+  SafeMap,
   Symbol,
 } = primordials;
 
@@ -36,6 +37,11 @@ const {
   disableHooks,
   updatePromiseHookMode,
   executionAsyncResource,
+  enableAsyncContextFrame,
+  disableAsyncContextFrame,
+  getAsyncContextFrame,
+  setAsyncContextFrame,
+  captureAsyncContextFrame,
   // Internal Embedder API
   newAsyncId,
   getDefaultTriggerAsyncId,
@@ -171,6 +177,7 @@ class AsyncResource {
     const asyncId = newAsyncId();
     this[async_id_symbol] = asyncId;
     this[trigger_async_id_symbol] = triggerAsyncId;
+    captureAsyncContextFrame(this);
 
     if (initHooksExist()) {
       if (enabledHooksExist() && type.length === 0) {
@@ -246,17 +253,6 @@ class AsyncResource {
   }
 }
 
-const storageList = [];
-const storageHook = createHook({
-  init(asyncId, type, triggerAsyncId, resource) {
-    const currentResource = executionAsyncResource();
-    // Value of currentResource is always a non null object
-    for (let i = 0; i < storageList.length; ++i) {
-      storageList[i]._propagate(resource, currentResource);
-    }
-  }
-});
-
 class AsyncLocalStorage {
   constructor() {
     this.kResourceStore = Symbol('kResourceStore');
@@ -266,54 +262,50 @@ class AsyncLocalStorage {
   disable() {
     if (this.enabled) {
       this.enabled = false;
-      // If this.enabled, the instance must be in storageList
-      ArrayPrototypeSplice(storageList,
-                           ArrayPrototypeIndexOf(storageList, this), 1);
-      if (storageList.length === 0) {
-        storageHook.disable();
-      }
+      // Frames that were captured so far may still contain stores of this
+      // instance. Use a new key so that they do not show up again if the
+      // instance is enabled later on.
+      this.kResourceStore = Symbol('kResourceStore');
+      disableAsyncContextFrame();
     }
   }
 
   _enable() {
     if (!this.enabled) {
       this.enabled = true;
-      ArrayPrototypePush(storageList, this);
-      storageHook.enable();
+      enableAsyncContextFrame();
     }
   }
 
-  // Propagate the context from a parent resource to a child one
-  _propagate(resource, triggerResource) {
-    const store = triggerResource[this.kResourceStore];
-    if (this.enabled) {
-      resource[this.kResourceStore] = store;
-    }
+  // Returns a copy of the current async context frame in which this
+  // instance's store is replaced. Frames are never modified in place, since
+  // resources that were created while they were current refer to them.
+  _frameWith(store) {
+    const frame = new SafeMap(getAsyncContextFrame());
+    frame.set(this.kResourceStore, store);
+    return frame;
   }
 
   enterWith(store) {
     this._enable();
-    const resource = executionAsyncResource();
-    resource[this.kResourceStore] = store;
+    setAsyncContextFrame(this._frameWith(store));
   }
 
   run(store, callback, ...args) {
-    // Avoid creation of an AsyncResource if store is already active
+    // Avoid creation of a new frame if store is already active
     if (ObjectIs(store, this.getStore())) {
       return ReflectApply(callback, null, args);
     }
 
     this._enable();
 
-    const resource = executionAsyncResource();
-    const oldStore = resource[this.kResourceStore];
-
-    resource[this.kResourceStore] = store;
+    const frame = getAsyncContextFrame();
+    setAsyncContextFrame(this._frameWith(store));
 
     try {
       return ReflectApply(callback, null, args);
     } finally {
-      resource[this.kResourceStore] = oldStore;
+      setAsyncContextFrame(frame);
     }
   }
 
@@ -321,18 +313,20 @@ class AsyncLocalStorage {
     if (!this.enabled) {
       return ReflectApply(callback, null, args);
     }
-    this.disable();
+    const frame = getAsyncContextFrame();
+    setAsyncContextFrame(this._frameWith(undefined));
     try {
       return ReflectApply(callback, null, args);
     } finally {
-      this._enable();
+      setAsyncContextFrame(frame);
     }
   }
 
   getStore() {
     if (this.enabled) {
-      const resource = executionAsyncResource();
-      return resource[this.kResourceStore];
+      const frame = getAsyncContextFrame();
+      if (frame !== undefined)
+        return frame.get(this.kResourceStore);
     }
   }
 }
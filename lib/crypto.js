@@ -98,7 +98,10 @@ const {
 } = require('internal/crypto/sig');
 const {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch,
+  hashFile
 } = require('internal/crypto/hash');
 const {
   getCiphers,
@@ -175,6 +178,9 @@ module.exports = {
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  hash,
+  hashBatch,
+  hashFile,
   pbkdf2,
   pbkdf2Sync,
   generateKeyPair,
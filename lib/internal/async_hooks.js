@@ -1,6 +1,8 @@
 'use strict';
 
 const {
+  ArrayPrototypePop,
+  ArrayPrototypePush,
   ArrayPrototypeSlice,
   ErrorCaptureStackTrace,
   ObjectPrototypeHasOwnProperty,
@@ -34,10 +36,17 @@ const { setCallbackTrampoline } = async_wrap;
  * popAsyncContext() call removes two doubles from it.
  * It has a fixed size, so if that is exceeded, calls to the native
  * side are used instead in pushAsyncContext() and popAsyncContext().
+ *
+ * async_context_frame is an Array whose first element is the current async
+ * context frame, an opaque value owned by AsyncLocalStorage. It is captured
+ * on resources when they are created and entered while their callbacks run.
+ * The element at index n + 1 holds the frame that was current before the
+ * n-th entry of the async id stack was pushed from JS.
  */
 const {
   async_hook_fields,
   async_id_fields,
+  async_context_frame,
   execution_async_resources
 } = async_wrap;
 // Store the pair executionAsyncId and triggerAsyncId in a AliasedFloat64Array
@@ -90,9 +99,11 @@ const {
   kInit, kBefore, kAfter, kDestroy, kTotals, kPromiseResolve,
   kCheck, kExecutionAsyncId, kAsyncIdCounter, kTriggerAsyncId,
   kDefaultTriggerAsyncId, kStackLength, kUsesExecutionAsyncResource,
+  kUsesAsyncContextFrame,
 } = async_wrap.constants;
 
-const { async_id_symbol,
+const { async_context_frame_symbol,
+        async_id_symbol,
         trigger_async_id_symbol } = internalBinding('symbols');
 
 // Lazy load of internal/util/inspect;
@@ -367,6 +378,35 @@ function promiseResolveHook(promise) {
   emitPromiseResolveNative(asyncId);
 }
 
+// Used instead of the hooks above when only AsyncLocalStorage needs to
+// follow promises. These do not allocate async ids or call into any hooks,
+// they only carry the async context frame from a promise's creation to its
+// reactions.
+const promiseFrameStack = [];
+
+function promiseFrameInitHook(promise) {
+  promise[async_context_frame_symbol] = async_context_frame[0];
+}
+
+function promiseFrameBeforeHook(promise) {
+  ArrayPrototypePush(promiseFrameStack, async_context_frame[0]);
+  async_context_frame[0] = promise[async_context_frame_symbol];
+}
+
+function promiseFrameAfterHook() {
+  async_context_frame[0] = ArrayPrototypePop(promiseFrameStack);
+}
+
+// When user hooks are enabled as well, their before and after hooks enter
+// and leave the promise's frame through pushAsyncContext() and
+// popAsyncContext(), so only the init hook needs to be extended.
+let promiseInitHookWithoutFrame;
+function promiseInitHookWithFrame(promise, parent) {
+  promiseFrameInitHook(promise);
+  if (promiseInitHookWithoutFrame !== undefined)
+    promiseInitHookWithoutFrame(promise, parent);
+}
+
 let wantPromiseHook = false;
 function enableHooks() {
   async_hook_fields[kCheck] += 1;
@@ -381,6 +421,10 @@ function updatePromiseHookMode() {
   } else if (destroyHooksExist()) {
     initHook = destroyTracking;
   }
+  if (asyncContextFrameEnabled()) {
+    promiseInitHookWithoutFrame = initHook;
+    initHook = promiseInitHookWithFrame;
+  }
   setPromiseHooks(
     initHook,
     promiseBeforeHook,
@@ -389,6 +433,15 @@ function updatePromiseHookMode() {
   );
 }
 
+function setPromiseFrameHooks() {
+  setPromiseHooks(
+    promiseFrameInitHook,
+    promiseFrameBeforeHook,
+    promiseFrameAfterHook,
+    undefined,
+  );
+}
+
 function disableHooks() {
   async_hook_fields[kCheck] -= 1;
 
@@ -401,10 +454,55 @@ function disableHooks() {
 
 function disablePromiseHookIfNecessary() {
   if (!wantPromiseHook) {
-    setPromiseHooks(undefined, undefined, undefined, undefined);
+    if (asyncContextFrameEnabled())
+      setPromiseFrameHooks();
+    else
+      setPromiseHooks(undefined, undefined, undefined, undefined);
+  }
+}
+
+// Async Context Frames //
+
+function asyncContextFrameEnabled() {
+  return hasHooks(kUsesAsyncContextFrame);
+}
+
+// Called once by each AsyncLocalStorage instance that gets enabled.
+function enableAsyncContextFrame() {
+  if (async_hook_fields[kUsesAsyncContextFrame]++ !== 0)
+    return;
+  if (wantPromiseHook)
+    updatePromiseHookMode();
+  else
+    setPromiseFrameHooks();
+}
+
+function disableAsyncContextFrame() {
+  if (--async_hook_fields[kUsesAsyncContextFrame] !== 0)
+    return;
+  async_context_frame[0] = undefined;
+  if (wantPromiseHook) {
+    updatePromiseHookMode();
+  } else {
+    // Same as in disableHooks(), we might be between the before and after
+    // calls of a Promise.
+    enqueueMicrotask(disablePromiseHookIfNecessary);
   }
 }
 
+function getAsyncContextFrame() {
+  return async_context_frame[0];
+}
+
+function setAsyncContextFrame(frame) {
+  async_context_frame[0] = frame;
+}
+
+function captureAsyncContextFrame(resource) {
+  if (hasHooks(kUsesAsyncContextFrame))
+    resource[async_context_frame_symbol] = async_context_frame[0];
+}
+
 // Internal Embedder API //
 
 // Increment the internal id counter and return the value. Important that the
@@ -527,6 +625,10 @@ function hasAsyncIdStack() {
 function pushAsyncContext(asyncId, triggerAsyncId, resource) {
   const offset = async_hook_fields[kStackLength];
   execution_async_resources[offset] = resource;
+  if (hasHooks(kUsesAsyncContextFrame)) {
+    async_context_frame[offset + 1] = async_context_frame[0];
+    async_context_frame[0] = resource?.[async_context_frame_symbol];
+  }
   if (offset * 2 >= async_wrap.async_ids_stack.length)
     return pushAsyncContext_(asyncId, triggerAsyncId);
   async_wrap.async_ids_stack[offset * 2] = async_id_fields[kExecutionAsyncId];
@@ -551,6 +653,10 @@ function popAsyncContext(asyncId) {
   async_id_fields[kExecutionAsyncId] = async_wrap.async_ids_stack[2 * offset];
   async_id_fields[kTriggerAsyncId] = async_wrap.async_ids_stack[2 * offset + 1];
   execution_async_resources.pop();
+  if (async_context_frame.length > offset + 1) {
+    async_context_frame[0] = async_context_frame[offset + 1];
+    async_context_frame.length = offset + 1;
+  }
   async_hook_fields[kStackLength] = offset;
   return offset > 0;
 }
@@ -585,6 +691,11 @@ module.exports = {
   clearAsyncIdStack,
   hasAsyncIdStack,
   executionAsyncResource,
+  enableAsyncContextFrame,
+  disableAsyncContextFrame,
+  getAsyncContextFrame,
+  setAsyncContextFrame,
+  captureAsyncContextFrame,
   // Internal Embedder API
   newAsyncId,
   getOrSetAsyncId,
@@ -1,13 +1,21 @@
 'use strict';
 
 const {
+  ArrayIsArray,
+  ArrayPrototypeMap,
+  ArrayPrototypePush,
+  MathMin,
   ObjectSetPrototypeOf,
   Symbol,
 } = primordials;
 
+const { AsyncWrap, Providers } = internalBinding('async_wrap');
 const {
   Hash: _Hash,
-  Hmac: _Hmac
+  Hmac: _Hmac,
+  hashFile: _hashFile,
+  oneShotDigest: _oneShotDigest,
+  oneShotDigestBatch: _oneShotDigestBatch
 } = internalBinding('crypto');
 
 const {
@@ -25,10 +33,22 @@ const { Buffer } = require('buffer');
 const {
   ERR_CRYPTO_HASH_FINALIZED,
   ERR_CRYPTO_HASH_UPDATE_FAILED,
-  ERR_INVALID_ARG_TYPE
+  ERR_CRYPTO_INVALID_DIGEST,
+  ERR_INVALID_ARG_TYPE,
+  ERR_UNKNOWN_ENCODING
 } = require('internal/errors').codes;
-const { validateEncoding, validateString, validateUint32 } =
-  require('internal/validators');
+const {
+  validateArray,
+  validateBoolean,
+  validateCallback,
+  validateEncoding,
+  validateInteger,
+  validateObject,
+  validateString,
+  validateUint32
+} = require('internal/validators');
+const { getValidatedPath } = require('internal/fs/utils');
+const { toNamespacedPath } = require('path');
 const { isArrayBufferView } = require('internal/util/types');
 const LazyTransform = require('internal/streams/lazy_transform');
 const kState = Symbol('kState');
@@ -140,7 +160,125 @@ Hmac.prototype.digest = function digest(outputEncoding) {
 Hmac.prototype._flush = Hash.prototype._flush;
 Hmac.prototype._transform = Hash.prototype._transform;
 
+function validateHashInput(data, name) {
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      name, ['string', 'Buffer', 'TypedArray', 'DataView'], data);
+  }
+}
+
+function hash(algorithm, data, outputEncoding = 'hex') {
+  validateString(algorithm, 'algorithm');
+  validateHashInput(data, 'data');
+  validateString(outputEncoding, 'outputEncoding');
+  if (outputEncoding !== 'buffer' && !Buffer.isEncoding(outputEncoding))
+    throw new ERR_UNKNOWN_ENCODING(outputEncoding);
+  const result = _oneShotDigest(algorithm, data, outputEncoding);
+  if (result === -1)
+    throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+  return result;
+}
+
+function hashBatch(algorithm, data) {
+  validateString(algorithm, 'algorithm');
+  validateArray(data, 'data');
+  // Read every element exactly once, so that getters cannot return something
+  // else by the time the binding looks at it.
+  const items = [];
+  const length = data.length;
+  for (let i = 0; i < length; i++) {
+    const item = data[i];
+    validateHashInput(item, `data[${i}]`);
+    ArrayPrototypePush(items, item);
+  }
+  const result = _oneShotDigestBatch(algorithm, items);
+  if (result === -1)
+    throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+  return result;
+}
+
+// Matches the default size of the libuv threadpool, so that hashing a long
+// list of files does not starve other threadpool users.
+const kDefaultHashFileConcurrency = 4;
+
+function hashFile(algorithm, paths, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  validateString(algorithm, 'algorithm');
+  validateCallback(callback);
+
+  let outputLength;
+  let encoding = 'buffer';
+  let useMmap = false;
+  let concurrency = kDefaultHashFileConcurrency;
+  if (options !== undefined) {
+    validateObject(options, 'options');
+    if (options.outputLength !== undefined) {
+      outputLength = options.outputLength;
+      validateUint32(outputLength, 'options.outputLength');
+    }
+    if (options.encoding !== undefined) {
+      encoding = options.encoding;
+      validateString(encoding, 'options.encoding');
+      if (encoding !== 'buffer' && !Buffer.isEncoding(encoding))
+        throw new ERR_UNKNOWN_ENCODING(encoding);
+    }
+    if (options.mmap !== undefined) {
+      useMmap = options.mmap;
+      validateBoolean(useMmap, 'options.mmap');
+    }
+    if (options.concurrency !== undefined) {
+      concurrency = options.concurrency;
+      validateInteger(concurrency, 'options.concurrency', 1);
+    }
+  }
+
+  const single = !ArrayIsArray(paths);
+  const list = ArrayPrototypeMap(single ? [paths] : paths, (path) => {
+    return toNamespacedPath(getValidatedPath(path));
+  });
+  const results = new Array(list.length);
+  if (list.length === 0) {
+    process.nextTick(callback, null, results);
+    return;
+  }
+
+  let next = 0;
+  let pending = list.length;
+  let failed = false;
+  function start() {
+    const index = next++;
+    const wrap = new AsyncWrap(Providers.HASHFILEREQUEST);
+    wrap.ondone = (err, digest) => {
+      if (failed) return;
+      if (err) {
+        failed = true;
+        return callback.call(wrap, err);
+      }
+      results[index] =
+        encoding === 'buffer' ? digest : digest.toString(encoding);
+      if (--pending === 0)
+        return callback.call(wrap, null, single ? results[0] : results);
+      if (next < list.length)
+        start();
+    };
+    const rc = _hashFile(list[index], algorithm, outputLength, useMmap, wrap);
+    if (rc === -1)
+      throw new ERR_CRYPTO_INVALID_DIGEST(algorithm);
+  }
+
+  // Only the first job can throw, all of them use the same algorithm.
+  concurrency = MathMin(concurrency, list.length);
+  for (let i = 0; i < concurrency; i++)
+    start();
+}
+
 module.exports = {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch,
+  hashFile
 };
@@ -2,28 +2,12 @@
 
 const {
   Symbol,
-  Date,
 } = primordials;
 
-const { setUnrefTimeout } = require('internal/timers');
 const { PerformanceEntry, notify } = internalBinding('performance');
 
-let utcCache;
-
-function utcDate() {
-  if (!utcCache) cache();
-  return utcCache;
-}
-
-function cache() {
-  const d = new Date();
-  utcCache = d.toUTCString();
-  setUnrefTimeout(resetCache, 1000 - d.getMilliseconds());
-}
-
-function resetCache() {
-  utcCache = undefined;
-}
+// The Date header value, refreshed once per second in C++.
+const { getUTCDate: utcDate } = internalBinding('http_parser');
 
 class HttpRequestTiming extends PerformanceEntry {
   constructor(statistics) {
@@ -3005,11 +3005,22 @@ function connectionListener(socket) {
   this.emit('session', session);
 }
 
+// The receive windows are never shrunk below the default window size of
+// 65535 bytes defined by RFC 7540, section 6.9.2, so that is also the lowest
+// useful upper bound for auto-tuning.
+function validateMaxAutoTunedWindowSize(options) {
+  if (options.maxAutoTunedWindowSize !== undefined) {
+    validateInt32(options.maxAutoTunedWindowSize, 'maxAutoTunedWindowSize',
+                  65535);
+  }
+}
+
 function initializeOptions(options) {
   assertIsObject(options, 'options');
   options = { ...options };
   assertIsObject(options.settings, 'options.settings');
   options.settings = { ...options.settings };
+  validateMaxAutoTunedWindowSize(options);
 
   if (options.maxSessionInvalidFrames !== undefined)
     validateUint32(options.maxSessionInvalidFrames, 'maxSessionInvalidFrames');
@@ -3179,6 +3190,7 @@ function connect(authority, options, listener) {
 
   assertIsObject(options, 'options');
   options = { ...options };
+  validateMaxAutoTunedWindowSize(options);
 
   if (typeof authority === 'string')
     authority = new URL(authority);
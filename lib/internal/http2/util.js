@@ -210,7 +210,10 @@ const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
 const IDX_OPTIONS_MAX_SETTINGS = 9;
-const IDX_OPTIONS_FLAGS = 10;
+const IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE = 10;
+const IDX_OPTIONS_FLAGS = 11;
+
+const kDefaultMaxAutoTunedWindowSize = 16 * 1024 * 1024;
 
 function updateOptionsBuffer(options) {
   let flags = 0;
@@ -264,6 +267,12 @@ function updateOptionsBuffer(options) {
     optionsBuffer[IDX_OPTIONS_MAX_SETTINGS] =
       MathMax(1, options.maxSettings);
   }
+  if (options.windowAutoTuning === true) {
+    flags |= (1 << IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE);
+    optionsBuffer[IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE] =
+      options.maxAutoTunedWindowSize !== undefined ?
+        options.maxAutoTunedWindowSize : kDefaultMaxAutoTunedWindowSize;
+  }
   optionsBuffer[IDX_OPTIONS_FLAGS] = flags;
 }
 
@@ -40,6 +40,38 @@ function assert(x, msg) {
   if (!x) throw new ERR_ASSERTION(msg || 'assertion error');
 }
 
+// Ensure that a previously passed in value is valid. Currently, the native
+// implementation always returns numbers <= Number.MAX_SAFE_INTEGER.
+function previousValueIsValid(num) {
+  return typeof num === 'number' &&
+      num <= NumberMAX_SAFE_INTEGER &&
+      num >= 0;
+}
+
+// Also used by worker.cpuUsage(), which returns values in the same format.
+function validateCpuUsageValue(prevValue) {
+  if (!previousValueIsValid(prevValue.user)) {
+    if (typeof prevValue !== 'object')
+      throw new ERR_INVALID_ARG_TYPE('prevValue', 'object', prevValue);
+
+    if (typeof prevValue.user !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('prevValue.user',
+                                     'number', prevValue.user);
+    }
+    throw new ERR_INVALID_OPT_VALUE.RangeError('prevValue.user',
+                                               prevValue.user);
+  }
+
+  if (!previousValueIsValid(prevValue.system)) {
+    if (typeof prevValue.system !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('prevValue.system',
+                                     'number', prevValue.system);
+    }
+    throw new ERR_INVALID_OPT_VALUE.RangeError('prevValue.system',
+                                               prevValue.system);
+  }
+}
+
 // The execution of this function itself should not cause any side effects.
 function wrapProcessMethods(binding) {
   const {
@@ -62,28 +94,8 @@ function wrapProcessMethods(binding) {
   // function.
   function cpuUsage(prevValue) {
     // If a previous value was passed in, ensure it has the correct shape.
-    if (prevValue) {
-      if (!previousValueIsValid(prevValue.user)) {
-        if (typeof prevValue !== 'object')
-          throw new ERR_INVALID_ARG_TYPE('prevValue', 'object', prevValue);
-
-        if (typeof prevValue.user !== 'number') {
-          throw new ERR_INVALID_ARG_TYPE('prevValue.user',
-                                         'number', prevValue.user);
-        }
-        throw new ERR_INVALID_OPT_VALUE.RangeError('prevValue.user',
-                                                   prevValue.user);
-      }
-
-      if (!previousValueIsValid(prevValue.system)) {
-        if (typeof prevValue.system !== 'number') {
-          throw new ERR_INVALID_ARG_TYPE('prevValue.system',
-                                         'number', prevValue.system);
-        }
-        throw new ERR_INVALID_OPT_VALUE.RangeError('prevValue.system',
-                                                   prevValue.system);
-      }
-    }
+    if (prevValue)
+      validateCpuUsageValue(prevValue);
 
     // Call the native function to get the current values.
     const errmsg = _cpuUsage(cpuValues);
@@ -106,14 +118,6 @@ function wrapProcessMethods(binding) {
     };
   }
 
-  // Ensure that a previously passed in value is valid. Currently, the native
-  // implementation always returns numbers <= Number.MAX_SAFE_INTEGER.
-  function previousValueIsValid(num) {
-    return typeof num === 'number' &&
-        num <= NumberMAX_SAFE_INTEGER &&
-        num >= 0;
-  }
-
   // The 3 entries filled in by the original process.hrtime contains
   // the upper/lower 32 bits of the second part of the value,
   // and the remaining nanoseconds of the value.
@@ -370,5 +374,6 @@ module.exports = {
   toggleTraceCategoryState,
   assert,
   buildAllowedFlags,
+  validateCpuUsageValue,
   wrapProcessMethods
 };
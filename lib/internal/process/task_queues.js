@@ -27,6 +27,7 @@ const {
   newAsyncId,
   initHooksExist,
   destroyHooksExist,
+  captureAsyncContextFrame,
   emitInit,
   emitBefore,
   emitAfter,
@@ -129,6 +130,7 @@ function nextTick(callback) {
     callback,
     args
   };
+  captureAsyncContextFrame(tickObject);
   if (initHooksExist())
     emitInit(asyncId, 'TickObject', triggerAsyncId, tickObject);
   queue.push(tickObject);
@@ -95,6 +95,7 @@ const {
   newAsyncId,
   initHooksExist,
   destroyHooksExist,
+  captureAsyncContextFrame,
   // The needed emit*() functions.
   emitInit,
   emitBefore,
@@ -156,6 +157,7 @@ function initAsyncResource(resource, type) {
   const asyncId = resource[async_id_symbol] = newAsyncId();
   const triggerAsyncId =
     resource[trigger_async_id_symbol] = getDefaultTriggerAsyncId();
+  captureAsyncContextFrame(resource);
   if (initHooksExist())
     emitInit(asyncId, type, triggerAsyncId, resource);
 }
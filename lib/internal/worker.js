@@ -2,12 +2,14 @@
 
 const {
   ArrayIsArray,
+  ArrayPrototypeForEach,
   ArrayPrototypeMap,
   ArrayPrototypePush,
   Float64Array,
   FunctionPrototypeBind,
   JSONStringify,
   MathMax,
+  NumberNaN,
   ObjectCreate,
   ObjectEntries,
   Promise,
@@ -29,6 +31,7 @@ const { timeOrigin } = internalBinding('performance');
 
 const errorCodes = require('internal/errors').codes;
 const {
+  ERR_CPU_USAGE,
   ERR_WORKER_NOT_RUNNING,
   ERR_WORKER_PATH,
   ERR_WORKER_UNSERIALIZABLE_ERROR,
@@ -38,6 +41,12 @@ const {
   ERR_INVALID_ARG_VALUE,
 } = errorCodes;
 const { getOptionValue } = require('internal/options');
+const {
+  validateArray,
+  validateInteger,
+  validateObject,
+  validateOneOf,
+} = require('internal/validators');
 
 const workerIo = require('internal/worker/io');
 const {
@@ -52,7 +61,11 @@ const {
   ReadableWorkerStdio,
   WritableWorkerStdio
 } = workerIo;
+const {
+  broadcastMessage: broadcastMessage_,
+} = internalBinding('messaging');
 const { deserializeError } = require('internal/error_serdes');
+const { validateCpuUsageValue } = require('internal/process/per_thread');
 const { fileURLToPath, isURLInstance, pathToFileURL } = require('internal/url');
 
 const {
@@ -65,7 +78,14 @@ const {
   kMaxOldGenerationSizeMb,
   kCodeRangeSizeMb,
   kStackSizeMb,
-  kTotalResourceLimitCount
+  kTotalResourceLimitCount,
+  kNiceness,
+  kSchedulingPolicy,
+  kNumaNode,
+  kTotalSchedulingOptionCount,
+  kSchedulingPolicyOther,
+  kSchedulingPolicyBatch,
+  kSchedulingPolicyIdle,
 } = internalBinding('worker');
 
 const kHandle = Symbol('kHandle');
@@ -78,6 +98,7 @@ const kOnErrorMessage = Symbol('kOnErrorMessage');
 const kParentSideStdio = Symbol('kParentSideStdio');
 const kLoopStartTime = Symbol('kLoopStartTime');
 const kIsOnline = Symbol('kIsOnline');
+const kCPUUsage = Symbol('kCPUUsage');
 
 const SHARE_ENV = SymbolFor('nodejs.worker_threads.SHARE_ENV');
 let debug = require('internal/util/debuglog').debuglog('worker', (fn) => {
@@ -186,12 +207,26 @@ class Worker extends EventEmitter {
         options.env);
     }
 
+    let cpuAffinity;
+    if (options.scheduling !== undefined) {
+      validateObject(options.scheduling, 'options.scheduling');
+      cpuAffinity = options.scheduling.cpuAffinity;
+      if (cpuAffinity !== undefined) {
+        validateArray(cpuAffinity, 'options.scheduling.cpuAffinity', 1);
+        ArrayPrototypeForEach(cpuAffinity, (cpu) => {
+          validateInteger(cpu, 'options.scheduling.cpuAffinity', 0, 1023);
+        });
+      }
+    }
+
     // Set up the C++ handle for the worker, as well as some internal wiring.
     this[kHandle] = new WorkerImpl(url,
                                    env === process.env ? null : env,
                                    options.execArgv,
                                    parseResourceLimits(options.resourceLimits),
-                                   !!options.trackUnmanagedFds);
+                                   !!options.trackUnmanagedFds,
+                                   parseScheduling(options.scheduling),
+                                   cpuAffinity);
     if (this[kHandle].invalidExecArgv) {
       throw new ERR_WORKER_INVALID_EXEC_ARGV(this[kHandle].invalidExecArgv);
     }
@@ -256,6 +291,7 @@ class Worker extends EventEmitter {
     // Use this to cache the Worker's loopStart value once available.
     this[kLoopStartTime] = -1;
     this[kIsOnline] = false;
+    this[kCPUUsage] = null;
     this.performance = {
       eventLoopUtilization: FunctionPrototypeBind(eventLoopUtilization, this),
     };
@@ -269,6 +305,8 @@ class Worker extends EventEmitter {
     debug(`[${threadId}] hears end event for Worker ${this.threadId}`);
     drainMessagePort(this[kPublicPort]);
     drainMessagePort(this[kPort]);
+    // The final CPU usage is only available until the handle is gone.
+    this[kCPUUsage] = readCPUUsage(this[kHandle]);
     this[kDispose]();
     if (customErr) {
       debug(`[${threadId}] failing with custom error ${customErr} \
@@ -404,6 +442,22 @@ class Worker extends EventEmitter {
     return makeResourceLimits(this[kHandle].getResourceLimits());
   }
 
+  cpuUsage(prevValue) {
+    if (prevValue)
+      validateCpuUsageValue(prevValue);
+
+    const usage = this[kHandle] === null ?
+      this[kCPUUsage] : readCPUUsage(this[kHandle]);
+
+    if (prevValue) {
+      return {
+        user: usage.user - prevValue.user,
+        system: usage.system - prevValue.system
+      };
+    }
+    return usage;
+  }
+
   getHeapSnapshot() {
     const heapSnapshotTaker = this[kHandle] && this[kHandle].takeHeapSnapshot();
     return new Promise((resolve, reject) => {
@@ -454,6 +508,43 @@ function makeResourceLimits(float64arr) {
   };
 }
 
+const schedulingArray = new Float64Array(kTotalSchedulingOptionCount);
+const schedulingPolicies = {
+  other: kSchedulingPolicyOther,
+  batch: kSchedulingPolicyBatch,
+  idle: kSchedulingPolicyIdle,
+};
+function parseScheduling(obj) {
+  const ret = schedulingArray;
+  TypedArrayPrototypeFill(ret, NumberNaN);
+  if (obj === undefined) return ret;
+
+  const { niceness, policy, numaNode } = obj;
+  if (niceness !== undefined) {
+    validateInteger(niceness, 'options.scheduling.niceness', -20, 19);
+    ret[kNiceness] = niceness;
+  }
+  if (policy !== undefined) {
+    validateOneOf(policy, 'options.scheduling.policy',
+                  ['other', 'batch', 'idle']);
+    ret[kSchedulingPolicy] = schedulingPolicies[policy];
+  }
+  if (numaNode !== undefined) {
+    validateInteger(numaNode, 'options.scheduling.numaNode', 0, 1023);
+    ret[kNumaNode] = numaNode;
+  }
+  return ret;
+}
+
+const cpuUsageArray = new Float64Array(2);
+function readCPUUsage(handle) {
+  const errmsg = handle.cpuUsage(cpuUsageArray);
+  if (errmsg) {
+    throw new ERR_CPU_USAGE(errmsg);
+  }
+  return { user: cpuUsageArray[0], system: cpuUsageArray[1] };
+}
+
 function eventLoopUtilization(util1, util2) {
   // TODO(trevnorris): Works to solve the thread-safe read/write issue of
   // loopTime, but has the drawback that it can't be set until the event loop
@@ -494,6 +585,22 @@ function eventLoopUtilization(util1, util2) {
   return { idle: idle_delta, active: active_delta, utilization };
 }
 
+function broadcastMessage(targets, value) {
+  validateArray(targets, 'targets');
+  const ports = [];
+  for (let i = 0; i < targets.length; i++) {
+    let target = targets[i];
+    if (target instanceof Worker) {
+      // Workers that have already exited are skipped, like in
+      // worker.postMessage().
+      target = target[kPublicPort];
+      if (target === null) continue;
+    }
+    ArrayPrototypePush(ports, target);
+  }
+  broadcastMessage_(ports, value);
+}
+
 // Duplicate code from performance.now() so don't need to require perf_hooks.
 function now() {
   const hr = process.hrtime();
@@ -509,6 +616,7 @@ module.exports = {
   setEnvironmentData,
   getEnvironmentData,
   assignEnvironmentData,
+  broadcastMessage,
   threadId,
   Worker,
 };
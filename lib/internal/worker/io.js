@@ -26,6 +26,7 @@ const {
   drainMessagePort,
   moveMessagePortToContext,
   receiveMessageOnPort: receiveMessageOnPort_,
+  setMessagePortBatchSize: setMessagePortBatchSize_,
   stopMessagePort
 } = internalBinding('messaging');
 const {
@@ -44,6 +45,7 @@ const {
   kRemoveListener,
 } = require('internal/event_target');
 const { inspect } = require('internal/util/inspect');
+const { validateUint32 } = require('internal/validators');
 
 const kIncrementsPortRef = Symbol('kIncrementsPortRef');
 const kName = Symbol('kName');
@@ -282,6 +284,11 @@ function receiveMessageOnPort(port) {
   return { message };
 }
 
+function setMessagePortBatchSize(port, size) {
+  validateUint32(size, 'size');
+  setMessagePortBatchSize_(port, size);
+}
+
 module.exports = {
   drainMessagePort,
   messageTypes,
@@ -293,6 +300,7 @@ module.exports = {
   MessagePort,
   MessageChannel,
   receiveMessageOnPort,
+  setMessagePortBatchSize,
   setupPortReferencing,
   ReadableWorkerStdio,
   WritableWorkerStdio,
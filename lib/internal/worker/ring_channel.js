@@ -0,0 +1,222 @@
+'use strict';
+
+const {
+  Float64Array,
+  FunctionPrototypeCall,
+  ObjectDefineProperties,
+  ObjectGetOwnPropertyDescriptors,
+  Symbol,
+} = primordials;
+
+const {
+  createRingChannel,
+  constants: {
+    kRingChannelStatsFieldsCount,
+  },
+} = internalBinding('ring_channel');
+const { owner_symbol } = internalBinding('symbols');
+
+const EventEmitter = require('events');
+const {
+  JSTransferable,
+  kClone,
+  kDeserialize,
+  kTransfer,
+  kTransferList,
+} = require('internal/worker/js_transferable');
+const { isArrayBufferView } = require('internal/util/types');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+  },
+} = require('internal/errors');
+const {
+  validateInteger,
+  validateObject,
+} = require('internal/validators');
+
+const kHandle = Symbol('kHandle');
+const kNeedDrain = Symbol('kNeedDrain');
+const kSetHandle = Symbol('kSetHandle');
+
+const kDefaultSize = 64 * 1024;
+const kMaxSize = 2 ** 30;
+
+// Keep in sync with RingChannelStatsFields in src/node_ring_channel.h.
+const kCapacity = 0;
+const kBytesUsed = 1;
+const kBytesWritten = 2;
+const kRecordsWritten = 3;
+const kBytesRead = 4;
+const kRecordsRead = 5;
+const kRejectedWrites = 6;
+
+const statsFields = new Float64Array(kRingChannelStatsFieldsCount);
+
+// Called from C++ when the consumer's ring went from empty to non-empty.
+function onReadable() {
+  this[owner_symbol].emit('readable');
+}
+
+// Called from C++ when the consumer made room after a write had failed.
+function onDrain() {
+  const producer = this[owner_symbol];
+  producer[kNeedDrain] = false;
+  producer.emit('drain');
+}
+
+class RingChannelEndpoint extends JSTransferable {
+  constructor(handle) {
+    super();
+    FunctionPrototypeCall(EventEmitter, this);
+    this[kHandle] = null;
+    // Endpoints that are created when deserializing a message get their
+    // handle through [kDeserialize]().
+    if (handle !== undefined)
+      this[kSetHandle](handle);
+  }
+
+  [kSetHandle](handle) {
+    handle[owner_symbol] = this;
+    this[kHandle] = handle;
+  }
+
+  getStats() {
+    const handle = this[kHandle];
+    if (handle === null)
+      return undefined;
+    handle.getStats(statsFields);
+    return {
+      capacity: statsFields[kCapacity],
+      bytesUsed: statsFields[kBytesUsed],
+      bytesWritten: statsFields[kBytesWritten],
+      recordsWritten: statsFields[kRecordsWritten],
+      bytesRead: statsFields[kBytesRead],
+      recordsRead: statsFields[kRecordsRead],
+      rejectedWrites: statsFields[kRejectedWrites],
+    };
+  }
+
+  close(callback) {
+    if (typeof callback === 'function')
+      this.once('close', callback);
+    const handle = this[kHandle];
+    if (handle !== null)
+      handle.close(() => this.emit('close'));
+  }
+
+  ref() {
+    const handle = this[kHandle];
+    if (handle !== null)
+      handle.ref();
+    return this;
+  }
+
+  unref() {
+    const handle = this[kHandle];
+    if (handle !== null)
+      handle.unref();
+    return this;
+  }
+}
+
+// Endpoints cannot extend both JSTransferable and EventEmitter, so the
+// EventEmitter methods are copied over.
+{
+  const methods = ObjectGetOwnPropertyDescriptors(EventEmitter.prototype);
+  delete methods.constructor;
+  ObjectDefineProperties(RingChannelEndpoint.prototype, methods);
+}
+
+class RingChannelProducer extends RingChannelEndpoint {
+  [kSetHandle](handle) {
+    super[kSetHandle](handle);
+    this[kNeedDrain] = false;
+    handle.ondrain = onDrain;
+  }
+
+  get writableNeedDrain() {
+    return this[kNeedDrain] === true;
+  }
+
+  write(data) {
+    if (!isArrayBufferView(data)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'data', ['Buffer', 'TypedArray', 'DataView'], data);
+    }
+    const handle = this[kHandle];
+    if (handle === null)
+      return false;
+    const written = handle.write(data);
+    if (!written)
+      this[kNeedDrain] = true;
+    return written;
+  }
+
+  // Producers are cloned rather than transferred, so that any number of
+  // threads can write into the same ring.
+  [kClone]() {
+    return {
+      data: { handle: this[kHandle] },
+      deserializeInfo: 'internal/worker/ring_channel:RingChannelProducer'
+    };
+  }
+
+  [kDeserialize]({ handle }) {
+    this[kSetHandle](handle);
+  }
+}
+
+class RingChannelConsumer extends RingChannelEndpoint {
+  [kSetHandle](handle) {
+    super[kSetHandle](handle);
+    handle.onreadable = onReadable;
+  }
+
+  read() {
+    const handle = this[kHandle];
+    if (handle === null)
+      return undefined;
+    return handle.read();
+  }
+
+  [kTransfer]() {
+    const handle = this[kHandle];
+    if (handle === null) {
+      const { DOMException } = internalBinding('messaging');
+      throw new DOMException('RingChannelConsumer was already transferred',
+                             'DataCloneError');
+    }
+    this[kHandle] = null;
+    return {
+      data: { handle },
+      deserializeInfo: 'internal/worker/ring_channel:RingChannelConsumer'
+    };
+  }
+
+  [kTransferList]() {
+    return [ this[kHandle] ];
+  }
+
+  [kDeserialize]({ handle }) {
+    this[kSetHandle](handle);
+  }
+}
+
+class RingChannel {
+  constructor(options = {}) {
+    validateObject(options, 'options');
+    const { size = kDefaultSize } = options;
+    validateInteger(size, 'options.size', 1, kMaxSize);
+
+    const { 0: producer, 1: consumer } = createRingChannel(size);
+    this.producer = new RingChannelProducer(producer);
+    this.consumer = new RingChannelConsumer(consumer);
+  }
+}
+
+module.exports = {
+  RingChannel,
+  RingChannelConsumer,
+  RingChannelProducer,
+};
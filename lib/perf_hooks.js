@@ -7,6 +7,7 @@ const {
   ArrayPrototypeIncludes,
   ArrayPrototypeMap,
   ArrayPrototypePush,
+  ArrayPrototypeSlice,
   ArrayPrototypeSplice,
   ArrayPrototypeUnshift,
   Boolean,
@@ -35,6 +36,10 @@ const {
   installGarbageCollectionTracking,
   removeGarbageCollectionTracking,
   loopIdleTime,
+  asyncCallbackStats,
+  asyncCallbackTypes,
+  setAsyncCallbackTracking,
+  getThreadPoolWorkStats,
 } = internalBinding('performance');
 
 const {
@@ -51,7 +56,11 @@ const {
   NODE_PERFORMANCE_MILESTONE_LOOP_START,
   NODE_PERFORMANCE_MILESTONE_LOOP_EXIT,
   NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE,
-  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT
+  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT,
+
+  NODE_PERFORMANCE_ASYNC_CALLBACK_COUNT,
+  NODE_PERFORMANCE_ASYNC_CALLBACK_DURATION,
+  NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS,
 } = constants;
 
 const { AsyncResource } = require('async_hooks');
@@ -85,6 +94,8 @@ const kGetEntries = Symbol('get-entries');
 const kIndex = Symbol('index');
 const kMarks = Symbol('marks');
 const kEnabled = Symbol('kEnabled');
+const kBaseline = Symbol('kBaseline');
+const kFinal = Symbol('kFinal');
 
 const observers = {};
 const observerableTypes = [
@@ -113,6 +124,8 @@ const IDX_SESSION_STATS_STREAMAVERAGEDURATION = 5;
 const IDX_SESSION_STATS_DATA_SENT = 6;
 const IDX_SESSION_STATS_DATA_RECEIVED = 7;
 const IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS = 8;
+const IDX_SESSION_STATS_WINDOW_SIZE_UPDATES = 9;
+const IDX_SESSION_STATS_AUTO_TUNED_WINDOW_SIZE = 10;
 
 let http2;
 let sessionStats;
@@ -158,6 +171,10 @@ function collectHttp2Stats(entry) {
         sessionStats[IDX_SESSION_STATS_DATA_RECEIVED];
       entry.maxConcurrentStreams =
         sessionStats[IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS];
+      entry.windowSizeUpdates =
+        sessionStats[IDX_SESSION_STATS_WINDOW_SIZE_UPDATES];
+      entry.autoTunedWindowSize =
+        sessionStats[IDX_SESSION_STATS_AUTO_TUNED_WINDOW_SIZE];
       break;
   }
 }
@@ -676,10 +693,69 @@ function monitorEventLoopDelay(options = {}) {
   return new ELDHistogram(new _ELDHistogram(resolution));
 }
 
+// Native tracking is shared by all monitors, and stays on as long as at
+// least one of them is enabled.
+let asyncCallbackMonitors = 0;
+
+class AsyncCallbackMonitor {
+  constructor() {
+    this[kEnabled] = false;
+    this[kBaseline] = ArrayPrototypeSlice(asyncCallbackStats);
+    this[kFinal] = this[kBaseline];
+  }
+  enable() {
+    if (this[kEnabled]) return false;
+    this[kEnabled] = true;
+    this[kBaseline] = ArrayPrototypeSlice(asyncCallbackStats);
+    this[kFinal] = undefined;
+    if (asyncCallbackMonitors++ === 0)
+      setAsyncCallbackTracking(true);
+    return true;
+  }
+  disable() {
+    if (!this[kEnabled]) return false;
+    this[kEnabled] = false;
+    this[kFinal] = ArrayPrototypeSlice(asyncCallbackStats);
+    if (--asyncCallbackMonitors === 0)
+      setAsyncCallbackTracking(false);
+    return true;
+  }
+  reset() {
+    this[kBaseline] = ArrayPrototypeSlice(this[kFinal] || asyncCallbackStats);
+  }
+  usage() {
+    const stats = this[kFinal] || asyncCallbackStats;
+    const baseline = this[kBaseline];
+    const usage = {};
+    for (let i = 0; i < asyncCallbackTypes.length; i++) {
+      const offset = i * NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS;
+      const countOffset = offset + NODE_PERFORMANCE_ASYNC_CALLBACK_COUNT;
+      const durationOffset = offset + NODE_PERFORMANCE_ASYNC_CALLBACK_DURATION;
+      const count = stats[countOffset] - baseline[countOffset];
+      if (count === 0) continue;
+      usage[asyncCallbackTypes[i]] = {
+        count,
+        duration: (stats[durationOffset] - baseline[durationOffset]) / 1e6
+      };
+    }
+    return usage;
+  }
+}
+
+function monitorAsyncCallbacks() {
+  return new AsyncCallbackMonitor();
+}
+
+function getThreadpoolStats() {
+  return getThreadPoolWorkStats();
+}
+
 module.exports = {
   performance,
   PerformanceObserver,
   monitorEventLoopDelay,
+  monitorAsyncCallbacks,
+  getThreadpoolStats,
   createHistogram,
 };
 
@@ -387,6 +387,7 @@ exports.parseCertString = internalUtil.deprecate(
 
 exports.createSecureContext = _tls_common.createSecureContext;
 exports.SecureContext = _tls_common.SecureContext;
+exports.SNICertStore = _tls_common.SNICertStore;
 exports.TLSSocket = _tls_wrap.TLSSocket;
 exports.Server = _tls_wrap.Server;
 exports.createServer = _tls_wrap.createServer;
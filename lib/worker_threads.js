@@ -1,6 +1,11 @@
 'use strict';
 
 const {
+  ObjectDefineProperty,
+} = primordials;
+
+const {
+  broadcastMessage,
   isMainThread,
   SHARE_ENV,
   resourceLimits,
@@ -15,6 +20,7 @@ const {
   MessageChannel,
   moveMessagePortToContext,
   receiveMessageOnPort,
+  setMessagePortBatchSize,
 } = require('internal/worker/io');
 
 const {
@@ -22,6 +28,7 @@ const {
 } = require('internal/buffer');
 
 module.exports = {
+  broadcastMessage,
   isMainThread,
   MessagePort,
   MessageChannel,
@@ -29,6 +36,7 @@ module.exports = {
   moveMessagePortToContext,
   receiveMessageOnPort,
   resourceLimits,
+  setMessagePortBatchSize,
   threadId,
   SHARE_ENV,
   Worker,
@@ -37,3 +45,15 @@ module.exports = {
   setEnvironmentData,
   getEnvironmentData,
 };
+
+// Loaded lazily, so that it is not part of every Worker's bootstrap.
+let RingChannel;
+ObjectDefineProperty(module.exports, 'RingChannel', {
+  configurable: true,
+  enumerable: true,
+  get() {
+    if (RingChannel === undefined)
+      RingChannel = require('internal/worker/ring_channel').RingChannel;
+    return RingChannel;
+  }
+});
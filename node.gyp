@@ -407,6 +407,7 @@
         'src/node_report.cc',
         'src/node_report_module.cc',
         'src/node_report_utils.cc',
+        'src/node_ring_channel.cc',
         'src/node_serdes.cc',
         'src/node_sockaddr.cc',
         'src/node_stat_watcher.cc',
@@ -510,6 +511,7 @@
         'src/node_process-inl.h',
         'src/node_report.h',
         'src/node_revert.h',
+        'src/node_ring_channel.h',
         'src/node_root_certs.h',
         'src/node_sockaddr.h',
         'src/node_sockaddr-inl.h',
@@ -1059,6 +1061,7 @@
         'test/cctest/test_aliased_buffer.cc',
         'test/cctest/test_base64.cc',
         'test/cctest/test_base_object_ptr.cc',
+        'test/cctest/test_callback_queue.cc',
         'test/cctest/test_node_postmortem_metadata.cc',
         'test/cctest/test_environment.cc',
         'test/cctest/test_js_native_api_v8.cc',
@@ -15,6 +15,7 @@ using v8::MaybeLocal;
 using v8::MicrotasksScope;
 using v8::Object;
 using v8::String;
+using v8::Undefined;
 using v8::Value;
 
 CallbackScope::CallbackScope(Isolate* isolate,
@@ -43,7 +44,11 @@ InternalCallbackScope::InternalCallbackScope(AsyncWrap* async_wrap, int flags)
                             async_wrap->object(),
                             { async_wrap->get_async_id(),
                               async_wrap->get_trigger_async_id() },
-                            flags) {}
+                            flags) {
+  async_callback_timer_.Start(env_->performance_state(),
+                              async_wrap->provider_type(),
+                              async_wrap->get_async_id());
+}
 
 InternalCallbackScope::InternalCallbackScope(Environment* env,
                                              Local<Object> object,
@@ -62,6 +67,21 @@ InternalCallbackScope::InternalCallbackScope(Environment* env,
     return;
   }
 
+  // Enter the async context frame that was captured when the resource was
+  // created. This happens outside of the HandleScope below, so that the
+  // previous frame stays alive until Close() restores it.
+  AsyncHooks* async_hooks = env->async_hooks();
+  if (async_hooks->uses_async_context_frame() && !object.IsEmpty()) {
+    Local<Value> frame;
+    if (!object->Get(env->context(), env->async_context_frame_symbol())
+             .ToLocal(&frame)) {
+      frame = Undefined(env->isolate());
+    }
+    prior_async_context_frame_ = async_hooks->async_context_frame();
+    async_hooks->set_async_context_frame(frame);
+    entered_async_context_frame_ = true;
+  }
+
   HandleScope handle_scope(env->isolate());
   // If you hit this assertion, you forgot to enter the v8::Context first.
   CHECK_EQ(Environment::GetCurrent(env->isolate()), env);
@@ -107,6 +127,10 @@ void InternalCallbackScope::Close() {
   if (pushed_ids_)
     env_->async_hooks()->pop_async_context(async_context_.async_id);
 
+  if (entered_async_context_frame_) {
+    env_->async_hooks()->set_async_context_frame(prior_async_context_frame_);
+  }
+
   if (failed_) return;
 
   if (env_->async_callback_scope_depth() > 1 || skip_task_queues_) {
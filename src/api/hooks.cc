@@ -217,6 +217,11 @@ async_context EmitAsyncInit(Isolate* isolate,
   AsyncWrap::EmitAsyncInit(env, resource, name, context.async_id,
                            context.trigger_async_id);
 
+  if (env->async_hooks()->uses_async_context_frame()) {
+    HandleScope scope(isolate);
+    env->async_hooks()->CaptureAsyncContextFrame(resource);
+  }
+
   return context;
 }
 
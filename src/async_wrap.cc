@@ -438,6 +438,10 @@ void AsyncWrap::Initialize(Local<Object> target,
                          "execution_async_resources",
                          env->async_hooks()->js_execution_async_resources());
 
+  FORCE_SET_TARGET_FIELD(target,
+                         "async_context_frame",
+                         env->async_hooks()->js_async_context_frame());
+
   target->Set(context,
               env->async_ids_stack_string(),
               env->async_hooks()->async_ids_stack().GetJSArray()).Check();
@@ -459,6 +463,7 @@ void AsyncWrap::Initialize(Local<Object> target,
   SET_HOOKS_CONSTANT(kAsyncIdCounter);
   SET_HOOKS_CONSTANT(kDefaultTriggerAsyncId);
   SET_HOOKS_CONSTANT(kUsesExecutionAsyncResource);
+  SET_HOOKS_CONSTANT(kUsesAsyncContextFrame);
   SET_HOOKS_CONSTANT(kStackLength);
 #undef SET_HOOKS_CONSTANT
   FORCE_SET_TARGET_FIELD(target, "constants", constants);
@@ -615,6 +620,7 @@ void AsyncWrap::AsyncReset(Local<Object> resource, double execution_async_id,
     if (resource != obj) {
       USE(obj->Set(env()->context(), env()->resource_symbol(), resource));
     }
+    env()->async_hooks()->CaptureAsyncContextFrame(obj);
   }
 
   switch (provider_type()) {
@@ -682,6 +688,8 @@ MaybeLocal<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
   EmitTraceEventBefore();
 
   ProviderType provider = provider_type();
+  performance::AsyncCallbackTimer async_callback_timer(
+      env()->performance_state(), provider, get_async_id());
   async_context context { get_async_id(), get_trigger_async_id() };
   MaybeLocal<Value> ret = InternalMakeCallback(
       env(), object(), object(), cb, argc, argv, context);
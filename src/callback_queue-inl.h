@@ -51,6 +51,58 @@ void CallbackQueue<R, Args...>::ConcatMove(CallbackQueue<R, Args...>&& other) {
   other.size_ = 0;
 }
 
+template <typename R, typename... Args>
+bool CallbackQueue<R, Args...>::PushThreadsafe(std::unique_ptr<Callback> cb) {
+  // Count the entry before publishing it, so that a size() of 0 always means
+  // that there is nothing to pick up.
+  size_++;
+  Callback* entry = cb.release();
+  Callback* head = threadsafe_head_.load(std::memory_order_relaxed);
+  do {
+    entry->threadsafe_next_ = head;
+  } while (!threadsafe_head_.compare_exchange_weak(head,
+                                                   entry,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed));
+  return head == nullptr;
+}
+
+template <typename R, typename... Args>
+void CallbackQueue<R, Args...>::ConcatMoveThreadsafe(
+    CallbackQueue<R, Args...>&& other) {
+  Callback* entry =
+      other.threadsafe_head_.exchange(nullptr, std::memory_order_acquire);
+  if (entry == nullptr)
+    return;
+
+  // The list is in reverse order, so build the new part of this queue
+  // back to front.
+  CallbackQueue taken;
+  taken.tail_ = entry;
+  size_t count = 0;
+  while (entry != nullptr) {
+    Callback* next = entry->threadsafe_next_;
+    entry->threadsafe_next_ = nullptr;
+    entry->set_next(std::move(taken.head_));
+    taken.head_.reset(entry);
+    entry = next;
+    count++;
+  }
+  taken.size_ = count;
+  other.size_ -= count;
+  ConcatMove(std::move(taken));
+}
+
+template <typename R, typename... Args>
+CallbackQueue<R, Args...>::~CallbackQueue() {
+  Callback* entry = threadsafe_head_.load();
+  while (entry != nullptr) {
+    Callback* next = entry->threadsafe_next_;
+    delete entry;
+    entry = next;
+  }
+}
+
 template <typename R, typename... Args>
 size_t CallbackQueue<R, Args...>::size() const {
   return size_.load();
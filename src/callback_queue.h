@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include <atomic>
+#include <memory>
 
 namespace node {
 
@@ -20,9 +21,18 @@ enum Flags {
 // `Shift()`.
 // The `refed` flag is left for easier use in situations in which some of these
 // should be run even if nothing else is keeping the event loop alive.
+//
+// Entries may also be added from any thread without locking using
+// `PushThreadsafe()`. Those are kept on a separate lock-free list until the
+// owning thread moves them over using `ConcatMoveThreadsafe()`.
 template <typename R, typename... Args>
 class CallbackQueue {
  public:
+  CallbackQueue() = default;
+  inline ~CallbackQueue();
+  CallbackQueue(const CallbackQueue&) = delete;
+  CallbackQueue& operator=(const CallbackQueue&) = delete;
+
   class Callback {
    public:
     explicit inline Callback(CallbackFlags::Flags flags);
@@ -38,6 +48,10 @@ class CallbackQueue {
 
     CallbackFlags::Flags flags_;
     std::unique_ptr<Callback> next_;
+    // Link on the list of entries added through PushThreadsafe(). This is a
+    // raw pointer because ownership is only taken over once the entry has
+    // been moved to the regular list.
+    Callback* threadsafe_next_ = nullptr;
 
     friend class CallbackQueue;
   };
@@ -52,6 +66,17 @@ class CallbackQueue {
   // 'other' afterwards.
   inline void ConcatMove(CallbackQueue&& other);
 
+  // PushThreadsafe() may be called from any thread, concurrently with other
+  // PushThreadsafe() calls and with ConcatMoveThreadsafe() on the thread that
+  // owns the queue. It returns true if no other entries added this way were
+  // pending, i.e. if the owning thread needs to be notified; entries added
+  // while others are pending are picked up together with those.
+  inline bool PushThreadsafe(std::unique_ptr<Callback> cb);
+  // ConcatMoveThreadsafe adds the elements that were added to 'other' through
+  // PushThreadsafe() to the end of this list, in the order in which they were
+  // added.
+  inline void ConcatMoveThreadsafe(CallbackQueue&& other);
+
   // size() is atomic and may be called from any thread.
   inline size_t size() const;
 
@@ -69,6 +94,8 @@ class CallbackQueue {
   std::atomic<size_t> size_ {0};
   std::unique_ptr<Callback> head_;
   Callback* tail_ = nullptr;
+  // Entries added through PushThreadsafe(), most recently added first.
+  std::atomic<Callback*> threadsafe_head_ {nullptr};
 };
 
 }  // namespace node
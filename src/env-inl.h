@@ -118,6 +118,37 @@ v8::Local<v8::Object> AsyncHooks::native_execution_async_resource(size_t i) {
   return PersistentToLocal::Strong(native_execution_async_resources_[i]);
 }
 
+v8::Local<v8::Array> AsyncHooks::js_async_context_frame() {
+  if (UNLIKELY(js_async_context_frame_.IsEmpty())) {
+    v8::Local<v8::Value> frame = v8::Undefined(env()->isolate());
+    js_async_context_frame_.Reset(
+        env()->isolate(), v8::Array::New(env()->isolate(), &frame, 1));
+  }
+  return PersistentToLocal::Strong(js_async_context_frame_);
+}
+
+inline bool AsyncHooks::uses_async_context_frame() {
+  return fields_[kUsesAsyncContextFrame] > 0;
+}
+
+inline v8::Local<v8::Value> AsyncHooks::async_context_frame() {
+  return js_async_context_frame()->Get(env()->context(), 0)
+      .FromMaybe(v8::Local<v8::Value>(v8::Undefined(env()->isolate())));
+}
+
+inline void AsyncHooks::set_async_context_frame(
+    v8::Local<v8::Value> frame) {
+  USE(js_async_context_frame()->Set(env()->context(), 0, frame));
+}
+
+inline void AsyncHooks::CaptureAsyncContextFrame(
+    v8::Local<v8::Object> resource) {
+  if (!uses_async_context_frame()) return;
+  USE(resource->Set(env()->context(),
+                    env()->async_context_frame_symbol(),
+                    async_context_frame()));
+}
+
 inline void AsyncHooks::SetJSPromiseHooks(v8::Local<v8::Function> init,
                                           v8::Local<v8::Function> before,
                                           v8::Local<v8::Function> after,
@@ -254,6 +285,17 @@ void AsyncHooks::clear_async_id_stack() {
   native_execution_async_resources_.clear();
   native_execution_async_resources_.shrink_to_fit();
 
+  // Leave whatever async context frame the cleared entries had entered, and
+  // drop the frames that JS saved for them.
+  if (!js_async_context_frame_.IsEmpty()) {
+    v8::Local<v8::Array> frame =
+        PersistentToLocal::Strong(js_async_context_frame_);
+    USE(frame->Set(env()->context(), 0, v8::Undefined(isolate)));
+    USE(frame->Set(env()->context(),
+                   env()->length_string(),
+                   v8::Integer::NewFromUnsigned(isolate, 1)));
+  }
+
   async_id_fields_[kExecutionAsyncId] = 0;
   async_id_fields_[kTriggerAsyncId] = 0;
   fields_[kStackLength] = 0;
@@ -841,27 +883,25 @@ template <typename Fn>
 void Environment::SetImmediateThreadsafe(Fn&& cb, CallbackFlags::Flags flags) {
   auto callback = native_immediates_threadsafe_.CreateCallback(
       std::move(cb), flags);
-  {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-    native_immediates_threadsafe_.Push(std::move(callback));
-    if (task_queues_async_initialized_)
-      uv_async_send(&task_queues_async_);
-  }
+  if (native_immediates_threadsafe_.PushThreadsafe(std::move(callback)))
+    TriggerTaskQueuesAsync();
 }
 
 template <typename Fn>
 void Environment::RequestInterrupt(Fn&& cb) {
   auto callback = native_immediates_interrupts_.CreateCallback(
       std::move(cb), CallbackFlags::kRefed);
-  {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-    native_immediates_interrupts_.Push(std::move(callback));
-    if (task_queues_async_initialized_)
-      uv_async_send(&task_queues_async_);
-  }
+  if (native_immediates_interrupts_.PushThreadsafe(std::move(callback)))
+    TriggerTaskQueuesAsync();
   RequestInterruptFromV8();
 }
 
+void Environment::TriggerTaskQueuesAsync() {
+  Mutex::ScopedLock lock(task_queues_async_mutex_);
+  if (task_queues_async_initialized_)
+    uv_async_send(&task_queues_async_);
+}
+
 inline bool Environment::can_call_into_js() const {
   return can_call_into_js_ && !is_stopping();
 }
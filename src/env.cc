@@ -547,7 +547,7 @@ void Environment::InitializeLibuv() {
   uv_unref(reinterpret_cast<uv_handle_t*>(&task_queues_async_));
 
   {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
+    Mutex::ScopedLock lock(task_queues_async_mutex_);
     task_queues_async_initialized_ = true;
     if (native_immediates_threadsafe_.size() > 0 ||
         native_immediates_interrupts_.size() > 0) {
@@ -596,7 +596,7 @@ void Environment::RegisterHandleCleanups() {
 
 void Environment::CleanupHandles() {
   {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
+    Mutex::ScopedLock lock(task_queues_async_mutex_);
     task_queues_async_initialized_ = false;
   }
 
@@ -706,10 +706,11 @@ void Environment::AtExit(void (*cb)(void* arg), void* arg) {
 void Environment::RunAndClearInterrupts() {
   while (native_immediates_interrupts_.size() > 0) {
     NativeImmediateQueue queue;
-    {
-      Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-      queue.ConcatMove(std::move(native_immediates_interrupts_));
-    }
+    queue.ConcatMoveThreadsafe(std::move(native_immediates_interrupts_));
+    // An entry may have been counted but not published yet. Its producer
+    // will wake us up again once it is.
+    if (queue.size() == 0)
+      break;
     DebugSealHandleScope seal_handle_scope(isolate());
 
     while (auto head = queue.Shift())
@@ -758,18 +759,15 @@ void Environment::RunAndClearNativeImmediates(bool only_refed) {
   if (immediate_info()->ref_count() == 0)
     ToggleImmediateRef(false);
 
-  // It is safe to check .size() first, because there is a causal relationship
-  // between pushes to the threadsafe immediate list and this function being
-  // called. For the common case, it's worth checking the size first before
-  // establishing a mutex lock.
+  // Taking the threadsafe immediates does not need a lock. Producers only
+  // wake up the event loop when they add to an empty list, so everything
+  // that was added since the last wakeup is picked up here at once.
   // This is intentionally placed after the `ref_count` handling, because when
   // refed threadsafe immediates are created, they are not counted towards the
   // count in immediate_info() either.
   NativeImmediateQueue threadsafe_immediates;
-  if (native_immediates_threadsafe_.size() > 0) {
-    Mutex::ScopedLock lock(native_immediates_threadsafe_mutex_);
-    threadsafe_immediates.ConcatMove(std::move(native_immediates_threadsafe_));
-  }
+  threadsafe_immediates.ConcatMoveThreadsafe(
+      std::move(native_immediates_threadsafe_));
   while (drain_list(&threadsafe_immediates)) {}
 }
 
@@ -833,6 +831,9 @@ void Environment::RunTimers(uv_timer_t* handle) {
   Context::Scope context_scope(env->context());
 
   Local<Object> process = env->process_object();
+  performance::AsyncCallbackTimer async_callback_timer(
+      env->performance_state(),
+      performance::NODE_PERFORMANCE_ASYNC_CALLBACK_TIMEOUT);
   InternalCallbackScope scope(env, process, {0, 0});
 
   Local<Function> cb = env->timers_callback_function();
@@ -897,6 +898,9 @@ void Environment::CheckImmediate(uv_check_t* handle) {
     return;
 
   do {
+    performance::AsyncCallbackTimer async_callback_timer(
+        env->performance_state(),
+        performance::NODE_PERFORMANCE_ASYNC_CALLBACK_IMMEDIATE);
     MakeCallback(env->isolate(),
                  env->process_object(),
                  env->immediate_callback_function(),
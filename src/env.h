@@ -157,6 +157,7 @@ constexpr size_t kFsStatsBufferLength =
 // Symbols are per-isolate primitives but Environment proxies them
 // for the sake of convenience.
 #define PER_ISOLATE_SYMBOL_PROPERTIES(V)                                       \
+  V(async_context_frame_symbol, "async_context_frame_symbol")                  \
   V(async_id_symbol, "async_id_symbol")                                        \
   V(handle_onclose_symbol, "handle_onclose")                                   \
   V(no_message_symbol, "no_message_symbol")                                    \
@@ -305,6 +306,7 @@ constexpr size_t kFsStatsBufferLength =
   V(oncomplete_string, "oncomplete")                                           \
   V(onconnection_string, "onconnection")                                       \
   V(ondone_string, "ondone")                                                   \
+  V(ondrain_string, "ondrain")                                                 \
   V(onerror_string, "onerror")                                                 \
   V(onexit_string, "onexit")                                                   \
   V(onhandshakedone_string, "onhandshakedone")                                 \
@@ -313,6 +315,7 @@ constexpr size_t kFsStatsBufferLength =
   V(onmessage_string, "onmessage")                                             \
   V(onnewsession_string, "onnewsession")                                       \
   V(onocspresponse_string, "onocspresponse")                                   \
+  V(onreadable_string, "onreadable")                                           \
   V(onreadstart_string, "onreadstart")                                         \
   V(onreadstop_string, "onreadstop")                                           \
   V(onshutdown_string, "onshutdown")                                           \
@@ -434,6 +437,7 @@ constexpr size_t kFsStatsBufferLength =
   V(microtask_queue_ctor_template, v8::FunctionTemplate)                       \
   V(pipe_constructor_template, v8::FunctionTemplate)                           \
   V(promise_wrap_template, v8::ObjectTemplate)                                 \
+  V(ring_channel_handle_constructor_template, v8::FunctionTemplate)            \
   V(sab_lifetimepartner_constructor_template, v8::FunctionTemplate)            \
   V(script_context_constructor_template, v8::FunctionTemplate)                 \
   V(secure_context_constructor_template, v8::FunctionTemplate)                 \
@@ -639,6 +643,7 @@ class AsyncHooks : public MemoryRetainer {
     kCheck,
     kStackLength,
     kUsesExecutionAsyncResource,
+    kUsesAsyncContextFrame,
     kFieldsCount,
   };
 
@@ -660,6 +665,18 @@ class AsyncHooks : public MemoryRetainer {
   // The `js_execution_async_resources` array contains the value in that case.
   inline v8::Local<v8::Object> native_execution_async_resource(size_t index);
 
+  // AsyncLocalStorage keeps its stores in an opaque async context frame that
+  // is captured when a resource is created and entered while its callbacks
+  // run. Element 0 of this array is the current frame; the following
+  // elements hold the frames saved by pushAsyncContext() in JS.
+  inline v8::Local<v8::Array> js_async_context_frame();
+  inline bool uses_async_context_frame();
+  inline v8::Local<v8::Value> async_context_frame();
+  inline void set_async_context_frame(v8::Local<v8::Value> frame);
+  // Stores the current frame on `resource`, if any AsyncLocalStorage is
+  // enabled.
+  inline void CaptureAsyncContextFrame(v8::Local<v8::Object> resource);
+
   inline void SetJSPromiseHooks(v8::Local<v8::Function> init,
                                 v8::Local<v8::Function> before,
                                 v8::Local<v8::Function> after,
@@ -721,6 +738,7 @@ class AsyncHooks : public MemoryRetainer {
 
   v8::Global<v8::Array> js_execution_async_resources_;
   std::vector<v8::Global<v8::Object>> native_execution_async_resources_;
+  v8::Global<v8::Array> js_async_context_frame_;
 
   std::vector<v8::Global<v8::Context>> contexts_;
 
@@ -1416,14 +1434,18 @@ class Environment : public MemoryRetainer {
 
   typedef CallbackQueue<void, Environment*> NativeImmediateQueue;
   NativeImmediateQueue native_immediates_;
-  Mutex native_immediates_threadsafe_mutex_;
+  // These two are filled from other threads through PushThreadsafe().
   NativeImmediateQueue native_immediates_threadsafe_;
   NativeImmediateQueue native_immediates_interrupts_;
-  // Also guarded by native_immediates_threadsafe_mutex_. This can be used when
-  // trying to post tasks from other threads to an Environment, as the libuv
-  // handle for the immediate queues (task_queues_async_) may not be initialized
-  // yet or already have been destroyed.
+  // Guarded by task_queues_async_mutex_. This can be used when trying to post
+  // tasks from other threads to an Environment, as the libuv handle for the
+  // immediate queues (task_queues_async_) may not be initialized yet or
+  // already have been destroyed.
+  Mutex task_queues_async_mutex_;
   bool task_queues_async_initialized_ = false;
+  // Wakes up the event loop after the first entry has been added to one of
+  // the threadsafe queues since they were last drained.
+  inline void TriggerTaskQueuesAsync();
 
   std::atomic<Environment**> interrupt_data_ {nullptr};
   void RequestInterruptFromV8();
@@ -26,6 +26,11 @@ int64_t Histogram::Max() {
   return hdr_max(histogram_.get());
 }
 
+int64_t Histogram::Count() {
+  Mutex::ScopedLock lock(mutex_);
+  return histogram_->total_count;
+}
+
 double Histogram::Mean() {
   Mutex::ScopedLock lock(mutex_);
   return hdr_mean(histogram_.get());
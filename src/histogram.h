@@ -36,6 +36,7 @@ class Histogram : public MemoryRetainer {
   inline double Stddev();
   inline double Percentile(double percentile);
   inline int64_t Exceeds() const { return exceeds_; }
+  inline int64_t Count();
 
   inline uint64_t RecordDelta();
 
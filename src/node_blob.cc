@@ -225,7 +225,7 @@ FixedSizeBlobCopyJob::FixedSizeBlobCopyJob(
     Blob* blob,
     FixedSizeBlobCopyJob::Mode mode)
     : AsyncWrap(env, object, AsyncWrap::PROVIDER_FIXEDSIZEBLOBCOPY),
-      ThreadPoolWork(env),
+      ThreadPoolWork(env, performance::NODE_PERFORMANCE_THREADPOOL_WORK_BLOB),
       mode_(mode) {
   if (mode == FixedSizeBlobCopyJob::Mode::SYNC) MakeWeak();
   source_ = blob->entries();
@@ -56,7 +56,12 @@
 #include <climits>  // INT_MAX
 #include <cstring>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif  // !_WIN32
+
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -77,6 +82,7 @@ using v8::DontDelete;
 using v8::Exception;
 using v8::External;
 using v8::False;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallback;
 using v8::FunctionCallbackInfo;
@@ -98,6 +104,7 @@ using v8::ReadOnly;
 using v8::SideEffectType;
 using v8::Signature;
 using v8::String;
+using v8::True;
 using v8::Uint32;
 using v8::Uint8Array;
 using v8::Undefined;
@@ -491,6 +498,7 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethodNoSideEffect(t, "getTicketKeys", GetTicketKeys);
   env->SetProtoMethod(t, "setTicketKeys", SetTicketKeys);
   env->SetProtoMethod(t, "setFreeListLength", SetFreeListLength);
+  env->SetProtoMethod(t, "setSNICertStore", SetSNICertStore);
   env->SetProtoMethod(t, "enableTicketKeyCallback", EnableTicketKeyCallback);
   env->SetProtoMethodNoSideEffect(t, "getCertificate", GetCertificate<true>);
   env->SetProtoMethodNoSideEffect(t, "getIssuer", GetCertificate<false>);
@@ -537,6 +545,7 @@ inline void SecureContext::Reset() {
   ctx_.reset();
   cert_.reset();
   issuer_.reset();
+  sni_cert_store_.reset();
 }
 
 SecureContext::~SecureContext() {
@@ -1556,6 +1565,22 @@ void SecureContext::SetFreeListLength(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void SecureContext::SetSNICertStore(const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+
+  if (args[0]->IsUndefined()) {
+    sc->sni_cert_store_.reset();
+    return;
+  }
+
+  CHECK(args[0]->IsObject());
+  SNICertStore* store;
+  ASSIGN_OR_RETURN_UNWRAP(&store, args[0].As<Object>());
+  sc->sni_cert_store_ = BaseObjectPtr<SNICertStore>(store);
+}
+
+
 // Currently, EnableTicketKeyCallback and TicketKeyCallback are only present for
 // the regression test in test/parallel/test-https-resume-after-renew.js.
 void SecureContext::EnableTicketKeyCallback(
@@ -1723,6 +1748,231 @@ void SecureContext::GetCertificate(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void SNICertStore::Initialize(Environment* env, Local<Object> target) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      SNICertStore::kInternalFieldCount);
+  t->Inherit(BaseObject::GetConstructorTemplate(env));
+
+  env->SetProtoMethod(t, "add", Add);
+  env->SetProtoMethod(t, "remove", Remove);
+  env->SetProtoMethodNoSideEffect(t, "getStats", GetStats);
+
+  env->SetConstructorFunction(target, "SNICertStore", t);
+}
+
+SNICertStore::SNICertStore(Environment* env,
+                           Local<Object> wrap,
+                           size_t max_cached)
+    : BaseObject(env, wrap),
+      max_cached_(max_cached) {
+  MakeWeak();
+}
+
+SNICertStore::~SNICertStore() {
+  env()->isolate()->AdjustAmountOfExternalAllocatedMemory(
+      -kExternalSize * static_cast<int64_t>(contexts_.size()));
+}
+
+void SNICertStore::MemoryInfo(MemoryTracker* tracker) const {
+  size_t entries_size = 0;
+  for (const auto& entry : entries_) {
+    entries_size += entry.first.size() +
+                    entry.second.cert.size() +
+                    entry.second.key.size();
+  }
+  tracker->TrackFieldWithSize("entries", entries_size);
+  tracker->TrackFieldWithSize("contexts", contexts_.size() * kExternalSize);
+}
+
+void SNICertStore::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsUint32());
+  uint32_t max_cached = args[0].As<Uint32>()->Value();
+  CHECK_GT(max_cached, 0);
+  new SNICertStore(env, args.This(), max_cached);
+}
+
+// add(servername, cert, key, passphrase, fromFile)
+void SNICertStore::Add(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SNICertStore* store;
+  ASSIGN_OR_RETURN_UNWRAP(&store, args.Holder());
+
+  CHECK(args[0]->IsString());
+  CHECK(args[4]->IsBoolean());
+
+  Entry entry;
+  entry.from_file = args[4]->IsTrue();
+  for (int i = 1; i <= 2; i++) {
+    std::string* out = i == 1 ? &entry.cert : &entry.key;
+    if (args[i]->IsString()) {
+      Utf8Value value(env->isolate(), args[i]);
+      out->assign(*value, value.length());
+    } else {
+      CHECK(args[i]->IsArrayBufferView());
+      ArrayBufferViewContents<char> value(args[i].As<ArrayBufferView>());
+      out->assign(value.data(), value.length());
+    }
+  }
+  if (args[3]->IsString()) {
+    Utf8Value passphrase(env->isolate(), args[3]);
+    entry.passphrase.assign(*passphrase, passphrase.length());
+  }
+
+  const std::string name = ToLower(*Utf8Value(env->isolate(), args[0]));
+  store->Uncache(name);
+  store->entries_[name] = std::move(entry);
+}
+
+void SNICertStore::Remove(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SNICertStore* store;
+  ASSIGN_OR_RETURN_UNWRAP(&store, args.Holder());
+
+  CHECK(args[0]->IsString());
+  const std::string name = ToLower(*Utf8Value(env->isolate(), args[0]));
+  store->Uncache(name);
+  args.GetReturnValue().Set(store->entries_.erase(name) > 0);
+}
+
+void SNICertStore::GetStats(const FunctionCallbackInfo<Value>& args) {
+  SNICertStore* store;
+  ASSIGN_OR_RETURN_UNWRAP(&store, args.Holder());
+
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), kStatsFieldsCount);
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+
+  store->stats_[kCachedContexts] = static_cast<double>(store->contexts_.size());
+  memcpy(fields, store->stats_, sizeof(store->stats_));
+}
+
+void SNICertStore::Uncache(const std::string& name) {
+  auto it = cached_.find(name);
+  if (it == cached_.end())
+    return;
+  contexts_.erase(it->second);
+  cached_.erase(it);
+  env()->isolate()->AdjustAmountOfExternalAllocatedMemory(-kExternalSize);
+}
+
+SSL_CTX* SNICertStore::Lookup(const char* servername) {
+  std::string name = ToLower(servername);
+  auto entry = entries_.find(name);
+  if (entry == entries_.end()) {
+    // Like checkServerIdentity(), a wildcard only stands for the leftmost
+    // label, so `*.example.com` does not match `a.b.example.com`.
+    size_t dot = name.find('.');
+    if (dot == std::string::npos)
+      return nullptr;
+    name = "*" + name.substr(dot);
+    entry = entries_.find(name);
+    if (entry == entries_.end())
+      return nullptr;
+  }
+
+  auto cached = cached_.find(name);
+  if (cached != cached_.end()) {
+    stats_[kHits]++;
+    contexts_.splice(contexts_.begin(), contexts_, cached->second);
+    return cached->second->second.get();
+  }
+
+  stats_[kMisses]++;
+  SSLCtxPointer ctx = LoadContext(entry->second);
+  if (!ctx) {
+    stats_[kLoadErrors]++;
+    return nullptr;
+  }
+
+  while (contexts_.size() >= max_cached_) {
+    stats_[kEvictions]++;
+    Uncache(contexts_.back().first);
+  }
+
+  contexts_.emplace_front(name, std::move(ctx));
+  cached_[name] = contexts_.begin();
+  env()->isolate()->AdjustAmountOfExternalAllocatedMemory(kExternalSize);
+  return contexts_.front().second.get();
+}
+
+static bool IsPEM(const std::string& data) {
+  return data.find("-----BEGIN") != std::string::npos;
+}
+
+SSLCtxPointer SNICertStore::LoadContext(const Entry& entry) {
+  ClearErrorOnReturn clear_error_on_return;
+
+  std::string cert_file;
+  std::string key_file;
+  const std::string* cert = &entry.cert;
+  const std::string* key = &entry.key;
+  auto cleanup = OnScopeLeave([&]() {
+    OPENSSL_cleanse(&key_file[0], key_file.size());
+  });
+
+  if (entry.from_file) {
+    if (ReadFileSync(&cert_file, entry.cert.c_str()) != 0 ||
+        ReadFileSync(&key_file, entry.key.c_str()) != 0) {
+      return SSLCtxPointer();
+    }
+    cert = &cert_file;
+    key = &key_file;
+  }
+
+  SSLCtxPointer ctx(SSL_CTX_new(TLS_server_method()));
+  if (!ctx)
+    return SSLCtxPointer();
+
+  if (IsPEM(*cert)) {
+    X509Pointer leaf;
+    X509Pointer issuer;
+    if (!SSL_CTX_use_certificate_chain(ctx.get(),
+                                       NodeBIO::NewFixed(cert->data(),
+                                                         cert->size()),
+                                       &leaf,
+                                       &issuer)) {
+      return SSLCtxPointer();
+    }
+  } else {
+    const unsigned char* p =
+        reinterpret_cast<const unsigned char*>(cert->data());
+    X509Pointer x509(d2i_X509(nullptr, &p, cert->size()));
+    if (!x509 || !SSL_CTX_use_certificate(ctx.get(), x509.get()))
+      return SSLCtxPointer();
+  }
+
+  EVPKeyPointer pkey;
+  if (IsPEM(*key)) {
+    BIOPointer bio(NodeBIO::NewFixed(key->data(), key->size()));
+    if (!bio)
+      return SSLCtxPointer();
+    char* passphrase = entry.passphrase.empty() ?
+        nullptr : const_cast<char*>(entry.passphrase.c_str());
+    pkey.reset(PEM_read_bio_PrivateKey(bio.get(),
+                                       nullptr,
+                                       PasswordCallback,
+                                       passphrase));
+  } else {
+    const unsigned char* p =
+        reinterpret_cast<const unsigned char*>(key->data());
+    pkey.reset(d2i_AutoPrivateKey(nullptr, &p, key->size()));
+  }
+
+  if (!pkey ||
+      !SSL_CTX_use_PrivateKey(ctx.get(), pkey.get()) ||
+      !SSL_CTX_check_private_key(ctx.get())) {
+    return SSLCtxPointer();
+  }
+
+  return ctx;
+}
+
+
 template <class Base>
 void SSLWrap<Base>::AddMethods(Environment* env, Local<FunctionTemplate> t) {
   HandleScope scope(env->isolate());
@@ -2460,6 +2710,11 @@ int SSLWrap<Base>::SSLCertCallback(SSL* s, void* arg) {
   const bool ocsp = (SSL_get_tlsext_status_type(s) == TLSEXT_STATUSTYPE_ocsp);
   info->Set(context, env->ocsp_request_string(),
             Boolean::New(env->isolate(), ocsp)).Check();
+  if (w->sni_context_from_store_) {
+    info->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "SNICertStoreMatch"),
+              True(env->isolate())).Check();
+  }
 
   Local<Value> argv[] = { info };
   w->MakeCallback(env->oncertcb_string(), arraysize(argv), argv);
@@ -3046,16 +3301,30 @@ static ManagedEVPPKey GetPrivateKeyFromJs(
   if (args[*offset]->IsString() || Buffer::HasInstance(args[*offset])) {
     Environment* env = Environment::GetCurrent(args);
     ByteSource key = ByteSource::FromStringOrBuffer(env, args[(*offset)++]);
-    NonCopyableMaybe<PrivateKeyEncodingConfig> config =
+    NonCopyableMaybe<PrivateKeyEncodingConfig> config_ =
         GetPrivateKeyEncodingFromJs(args, offset, kKeyContextInput);
-    if (config.IsEmpty())
+    if (config_.IsEmpty())
       return ManagedEVPPKey();
 
+    PrivateKeyEncodingConfig config = config_.Release();
+    ParsedKeyCache* cache =
+        &Environment::GetBindingData<BindingData>(args)->parsed_key_cache;
+    ParsedKeyCache::Id id;
+    if (ParsedKeyCache::GetId(
+            &id, ParsedKeyCache::kPrivateKeyOnly, config, key)) {
+      ManagedEVPPKey cached = cache->Get(id);
+      if (cached)
+        return cached;
+    }
+
     EVPKeyPointer pkey;
     ParseKeyResult ret =
-        ParsePrivateKey(&pkey, config.Release(), key.get(), key.size());
-    return GetParsedKey(env, std::move(pkey), ret,
-                        "Failed to read private key");
+        ParsePrivateKey(&pkey, config, key.get(), key.size());
+    ManagedEVPPKey result = GetParsedKey(env, std::move(pkey), ret,
+                                         "Failed to read private key");
+    if (result && !id.empty())
+      cache->Set(id, result);
+    return result;
   } else {
     CHECK(args[*offset]->IsObject() && allow_key_object);
     KeyObjectHandle* key;
@@ -3077,8 +3346,18 @@ static ManagedEVPPKey GetPublicOrPrivateKeyFromJs(
     if (config_.IsEmpty())
       return ManagedEVPPKey();
 
-    ParseKeyResult ret;
     PrivateKeyEncodingConfig config = config_.Release();
+    ParsedKeyCache* cache =
+        &Environment::GetBindingData<BindingData>(args)->parsed_key_cache;
+    ParsedKeyCache::Id id;
+    if (ParsedKeyCache::GetId(
+            &id, ParsedKeyCache::kPublicOrPrivateKey, config, data)) {
+      ManagedEVPPKey cached = cache->Get(id);
+      if (cached)
+        return cached;
+    }
+
+    ParseKeyResult ret;
     EVPKeyPointer pkey;
     if (config.format_ == kKeyFormatPEM) {
       // For PEM, we can easily determine whether it is a public or private key
@@ -3114,8 +3393,11 @@ static ManagedEVPPKey GetPublicOrPrivateKeyFromJs(
       }
     }
 
-    return GetParsedKey(env, std::move(pkey), ret,
-                        "Failed to read asymmetric key");
+    ManagedEVPPKey result = GetParsedKey(env, std::move(pkey), ret,
+                                         "Failed to read asymmetric key");
+    if (result && !id.empty())
+      cache->Set(id, result);
+    return result;
   } else {
     CHECK(args[*offset]->IsObject());
     KeyObjectHandle* key = Unwrap<KeyObjectHandle>(args[*offset].As<Object>());
@@ -3229,6 +3511,85 @@ EVP_PKEY* ManagedEVPPKey::get() const {
   return pkey_.get();
 }
 
+ParsedKeyCache::~ParsedKeyCache() {
+  while (!entries_.empty())
+    Erase(entries_.begin());
+}
+
+ParsedKeyCache::Id::~Id() {
+  if (!str_.empty())
+    OPENSSL_cleanse(&str_[0], str_.size());
+}
+
+bool ParsedKeyCache::GetId(Id* id,
+                           KeyUsage usage,
+                           const PrivateKeyEncodingConfig& config,
+                           const ByteSource& data) {
+  if (config.passphrase_ || data.size() > kMaxKeyDataLength)
+    return false;
+
+  // Reserve the full size up front, so that appending does not reallocate
+  // and leave copies of the key material behind.
+  std::string* str = &id->str_;
+  str->reserve(data.size() + 3);
+  str->push_back(usage);
+  str->push_back(static_cast<char>(config.format_));
+  str->push_back(config.type_.IsJust() ?
+      static_cast<char>(config.type_.FromJust()) : -1);
+  str->append(data.get(), data.size());
+  return true;
+}
+
+std::string ParsedKeyCache::Digest(const std::string& id) {
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  CHECK_EQ(EVP_Digest(id.data(), id.size(), md, &md_len, EVP_sha256(),
+                      nullptr), 1);
+  return std::string(reinterpret_cast<char*>(md), md_len);
+}
+
+ManagedEVPPKey ParsedKeyCache::Get(const Id& key) {
+  const std::string& id = key.str();
+  auto it = entries_.find(Digest(id));
+  if (it == entries_.end() ||
+      it->second.id.size() != id.size() ||
+      CRYPTO_memcmp(it->second.id.data(), id.data(), id.size()) != 0) {
+    misses_++;
+    return ManagedEVPPKey();
+  }
+
+  hits_++;
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  return it->second.pkey;
+}
+
+void ParsedKeyCache::Set(const Id& key, const ManagedEVPPKey& pkey) {
+  CHECK(pkey);
+  const std::string& id = key.str();
+  std::string digest = Digest(id);
+  if (entries_.count(digest) > 0)
+    return;
+
+  while (entries_.size() >= kMaxEntries)
+    Erase(entries_.find(*lru_.back()));
+
+  auto it = entries_.emplace(std::move(digest),
+                             Entry { pkey, id, lru_.end() }).first;
+  lru_.push_front(&it->first);
+  it->second.lru_position = lru_.begin();
+  byte_length_ += id.size();
+}
+
+void ParsedKeyCache::Erase(EntryMap::iterator it) {
+  // The id contains the key material, which may be a private key.
+  std::string& id = it->second.id;
+  if (!id.empty())
+    OPENSSL_cleanse(&id[0], id.size());
+  byte_length_ -= id.size();
+  lru_.erase(it->second.lru_position);
+  entries_.erase(it);
+}
+
 std::shared_ptr<KeyObjectData> KeyObjectData::CreateSecret(
     Local<ArrayBufferView> abv) {
   size_t key_len = abv->ByteLength();
@@ -4428,6 +4789,120 @@ void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+const EVP_MD* BindingData::GetDigest(const char* name) {
+  auto it = digests_.find(name);
+  if (it != digests_.end())
+    return it->second;
+  const EVP_MD* md = EVP_get_digestbyname(name);
+  // Only successful lookups are cached, so the map cannot grow without bound.
+  if (md != nullptr)
+    digests_.emplace(name, md);
+  return md;
+}
+
+
+bool BindingData::Digest(const EVP_MD* md,
+                         Local<Value> data,
+                         unsigned char* md_value) {
+  if (!mdctx_) {
+    mdctx_.reset(EVP_MD_CTX_new());
+    if (!mdctx_)
+      return false;
+  }
+  EVP_MD_CTX* mdctx = mdctx_.get();
+  if (EVP_DigestInit_ex(mdctx, md, nullptr) != 1)
+    return false;
+  if (data->IsArrayBufferView()) {
+    ArrayBufferViewContents<char> buf(data.As<ArrayBufferView>());
+    if (EVP_DigestUpdate(mdctx, buf.data(), buf.length()) != 1)
+      return false;
+  } else {
+    CHECK(data->IsString());
+    const node::Utf8Value buf(env()->isolate(), data);
+    if (EVP_DigestUpdate(mdctx, *buf, buf.length()) != 1)
+      return false;
+  }
+  return EVP_DigestFinal_ex(mdctx, md_value, nullptr) == 1;
+}
+
+
+// crypto.hash(): digests a single string or buffer without creating a Hash
+// object, using a digest context that is kept around per thread.
+static void OneShotDigest(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  CHECK(args[0]->IsString());  // algorithm
+  CHECK(args[1]->IsString() || args[1]->IsArrayBufferView());  // data
+  CHECK(args[2]->IsString());  // outputEncoding
+
+  const node::Utf8Value algorithm(env->isolate(), args[0]);
+  const EVP_MD* md = binding_data->GetDigest(*algorithm);
+  if (md == nullptr)
+    return args.GetReturnValue().Set(-1);
+
+  ClearErrorOnReturn clear_error_on_return;
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+  if (!binding_data->Digest(md, args[1], md_value))
+    return ThrowCryptoError(env, ERR_get_error());
+
+  const enum encoding encoding = ParseEncoding(env->isolate(), args[2], HEX);
+  Local<Value> error;
+  MaybeLocal<Value> rc =
+      StringBytes::Encode(env->isolate(),
+                          reinterpret_cast<const char*>(md_value),
+                          EVP_MD_size(md),
+                          encoding,
+                          &error);
+  if (rc.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    env->isolate()->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(rc.ToLocalChecked());
+}
+
+
+// crypto.hashBatch(): digests every element of an array and returns all
+// digests packed into a single buffer.
+static void OneShotDigestBatch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  CHECK(args[0]->IsString());  // algorithm
+  CHECK(args[1]->IsArray());  // data
+
+  const node::Utf8Value algorithm(env->isolate(), args[0]);
+  const EVP_MD* md = binding_data->GetDigest(*algorithm);
+  if (md == nullptr)
+    return args.GetReturnValue().Set(-1);
+
+  Local<Array> data = args[1].As<Array>();
+  const uint32_t length = data->Length();
+  const size_t md_len = EVP_MD_size(md);
+  AllocatedBuffer out =
+      AllocatedBuffer::AllocateManaged(env, md_len * length);
+  unsigned char* md_value = reinterpret_cast<unsigned char*>(out.data());
+
+  ClearErrorOnReturn clear_error_on_return;
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> item;
+    if (!data->Get(env->context(), i).ToLocal(&item))
+      return;
+    // JS passes a plain copy of the input, but a bad element must still not
+    // be able to abort the process.
+    if (!item->IsString() && !item->IsArrayBufferView()) {
+      return THROW_ERR_INVALID_ARG_TYPE(
+          env, "The \"data\" elements must be strings or ArrayBufferViews");
+    }
+    if (!binding_data->Digest(md, item, md_value + i * md_len))
+      return ThrowCryptoError(env, ERR_get_error());
+  }
+
+  Local<Object> buf;
+  if (out.ToBuffer().ToLocal(&buf))
+    args.GetReturnValue().Set(buf);
+}
+
+
 SignBase::Error SignBase::Init(const char* sign_type) {
   CHECK_NULL(mdctx_);
   // Historically, "dss1" and "DSS1" were DSA aliases for SHA-1
@@ -5798,7 +6273,9 @@ bool ECDH::IsKeyPairValid() {
 // this object. This makes proper reporting of memory usage impossible.
 struct CryptoJob : public ThreadPoolWork {
   std::unique_ptr<AsyncWrap> async_wrap;
-  inline explicit CryptoJob(Environment* env) : ThreadPoolWork(env) {}
+  inline explicit CryptoJob(Environment* env)
+      : ThreadPoolWork(env,
+                       performance::NODE_PERFORMANCE_THREADPOOL_WORK_CRYPTO) {}
   inline void AfterThreadPoolWork(int status) final;
   virtual void AfterThreadPoolWork() = 0;
   static inline void Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap);
@@ -5861,6 +6338,124 @@ struct RandomBytesJob : public CryptoJob {
 };
 
 
+// Incremented in the child process after every fork(). Entropy caches
+// compare it against the value they were filled under.
+static std::atomic<uint32_t> entropy_fork_generation{0};
+
+
+EntropyCache::Block::~Block() {
+  OPENSSL_cleanse(data, sizeof(data));
+}
+
+
+class EntropyCache::RefillJob final : public ThreadPoolWork {
+ public:
+  RefillJob(Environment* env, EntropyCache* cache, uint32_t fork_generation)
+      : ThreadPoolWork(env),
+        cache_(cache),
+        block_(new Block()),
+        fork_generation_(fork_generation) {}
+
+  void DoThreadPoolWork() override {
+    CheckEntropy();  // Ensure that OpenSSL's PRNG is properly seeded.
+    ok_ = RAND_bytes(block_->data, sizeof(block_->data)) == 1;
+    if (!ok_) ERR_clear_error();
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<RefillJob> job(this);
+    if (status != 0 || !ok_)
+      block_.reset();
+    cache_->OnRefill(std::move(block_), fork_generation_);
+  }
+
+ private:
+  EntropyCache* cache_;
+  std::unique_ptr<Block> block_;
+  uint32_t fork_generation_;
+  bool ok_ = false;
+};
+
+
+EntropyCache::EntropyCache(Environment* env)
+    : env_(env),
+      fork_generation_(entropy_fork_generation.load()) {}
+
+
+bool EntropyCache::Take(unsigned char* data, size_t size) {
+  if (size == 0 || size > kMaxRequestSize)
+    return false;
+
+  const uint32_t fork_generation = entropy_fork_generation.load();
+  if (fork_generation != fork_generation_) {
+    // The parent process may hand out the very same bytes, drop all of them.
+    // A refill that was in flight during fork() never completes in the child.
+    current_.reset();
+    next_.reset();
+    offset_ = kBlockSize;
+    refill_pending_ = false;
+    fork_generation_ = fork_generation;
+  }
+
+  if (kBlockSize - offset_ < size) {
+    if (!next_) {
+      misses_++;
+      ScheduleRefill();
+      return false;
+    }
+    // Whatever is left in the old block is wiped when it is destroyed.
+    current_ = std::move(next_);
+    offset_ = 0;
+  }
+
+  unsigned char* start = current_->data + offset_;
+  memcpy(data, start, size);
+  OPENSSL_cleanse(start, size);
+  offset_ += size;
+  hits_++;
+
+  if (!next_ && kBlockSize - offset_ < kRefillThreshold)
+    ScheduleRefill();
+  return true;
+}
+
+
+size_t EntropyCache::ByteLength() const {
+  return (current_ ? sizeof(Block) : 0) + (next_ ? sizeof(Block) : 0);
+}
+
+
+void EntropyCache::OnFork() {
+  entropy_fork_generation++;
+}
+
+
+void EntropyCache::ScheduleRefill() {
+  if (refill_pending_)
+    return;
+  refill_pending_ = true;
+  RefillJob* job = new RefillJob(env_, this, fork_generation_);
+  job->ScheduleWork();
+}
+
+
+void EntropyCache::OnRefill(std::unique_ptr<Block> block,
+                            uint32_t fork_generation) {
+  if (fork_generation != fork_generation_)
+    return;
+  refill_pending_ = false;
+  if (!block)
+    return;
+  refills_++;
+  if (current_ && offset_ < kBlockSize) {
+    next_ = std::move(block);
+  } else {
+    current_ = std::move(block);
+    offset_ = 0;
+  }
+}
+
+
 void RandomBytes(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsArrayBufferView());  // buffer; wrap object retains ref.
   CHECK(args[1]->IsUint32());  // offset
@@ -5871,11 +6466,20 @@ void RandomBytes(const FunctionCallbackInfo<Value>& args) {
   CHECK_GE(offset + size, offset);  // Overflow check.
   CHECK_LE(offset + size, Buffer::Length(args[0]));  // Bounds check.
   Environment* env = Environment::GetCurrent(args);
+  unsigned char* data =
+      reinterpret_cast<unsigned char*>(Buffer::Data(args[0])) + offset;
+  if (args[3]->IsUndefined()) {
+    env->PrintSyncTrace();
+    // Small synchronous requests are served from the entropy cache without
+    // touching OpenSSL or allocating a job.
+    BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+    if (binding_data->entropy_cache.Take(data, size))
+      return;
+  }
   std::unique_ptr<RandomBytesJob> job(new RandomBytesJob(env));
-  job->data = reinterpret_cast<unsigned char*>(Buffer::Data(args[0])) + offset;
+  job->data = data;
   job->size = size;
   if (args[3]->IsObject()) return RandomBytesJob::Run(std::move(job), args[3]);
-  env->PrintSyncTrace();
   job->DoThreadPoolWork();
   args.GetReturnValue().Set(job->ToResult());
 }
@@ -5949,6 +6553,159 @@ inline void PBKDF2(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Reads and digests a whole file on the threadpool, so that hashing a file
+// does not have to move every chunk through JS and back.
+struct HashFileJob : public CryptoJob {
+  // Files are read in chunks of this size. It is also the minimum size for
+  // which mapping the file is considered.
+  static constexpr size_t kReadBufferSize = 1024 * 1024;
+
+  std::string path;
+  const EVP_MD* md;
+  unsigned int md_len;
+  bool use_mmap = false;
+  std::unique_ptr<unsigned char[]> digest;
+  const char* syscall = nullptr;
+  int uv_error = 0;
+  CryptoErrorVector errors;
+
+  inline explicit HashFileJob(Environment* env) : CryptoJob(env) {}
+
+  inline void DoThreadPoolWork() override {
+    uv_fs_t req;
+    auto defer_req_cleanup = OnScopeLeave([&req]() {
+      uv_fs_req_cleanup(&req);
+    });
+
+    uv_file file = uv_fs_open(nullptr, &req, path.c_str(), O_RDONLY, 0,
+                              nullptr);
+    if (req.result < 0)
+      return SetUVError(req.result, "open");
+    uv_fs_req_cleanup(&req);
+
+    auto defer_close = OnScopeLeave([file]() {
+      uv_fs_t close_req;
+      CHECK_EQ(0, uv_fs_close(nullptr, &close_req, file, nullptr));
+      uv_fs_req_cleanup(&close_req);
+    });
+
+    EVPMDPointer mdctx(EVP_MD_CTX_new());
+    if (!mdctx || EVP_DigestInit_ex(mdctx.get(), md, nullptr) <= 0)
+      return errors.Capture();
+
+#ifndef _WIN32
+    if (use_mmap) {
+      uv_fs_fstat(nullptr, &req, file, nullptr);
+      if (req.result < 0)
+        return SetUVError(req.result, "fstat");
+      const uv_stat_t stat = req.statbuf;
+      uv_fs_req_cleanup(&req);
+      const size_t size = static_cast<size_t>(stat.st_size);
+      if ((stat.st_mode & S_IFMT) == S_IFREG && size >= kReadBufferSize) {
+        void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (addr != MAP_FAILED) {
+          madvise(addr, size, MADV_SEQUENTIAL);
+          const int ok = EVP_DigestUpdate(mdctx.get(), addr, size);
+          munmap(addr, size);
+          if (ok != 1)
+            return errors.Capture();
+          return Finish(mdctx.get());
+        }
+        // Fall back to reading the file.
+      }
+    }
+#endif  // !_WIN32
+
+    std::unique_ptr<char[]> buffer(new char[kReadBufferSize]);
+    uv_buf_t buf = uv_buf_init(buffer.get(), kReadBufferSize);
+    for (;;) {
+      const int r = uv_fs_read(nullptr, &req, file, &buf, 1, -1, nullptr);
+      if (req.result < 0)
+        return SetUVError(req.result, "read");
+      uv_fs_req_cleanup(&req);
+      if (r <= 0)
+        break;
+      if (EVP_DigestUpdate(mdctx.get(), buf.base, r) != 1)
+        return errors.Capture();
+    }
+    Finish(mdctx.get());
+  }
+
+  inline void SetUVError(ssize_t err, const char* syscall_name) {
+    uv_error = static_cast<int>(err);
+    syscall = syscall_name;
+  }
+
+  inline void Finish(EVP_MD_CTX* mdctx) {
+    digest.reset(new unsigned char[md_len > 0 ? md_len : 1]);
+    // See Hash::HashDigest() for why zero-length outputs are special.
+    if (md_len == 0)
+      return;
+    int ret;
+    if (md_len == static_cast<unsigned int>(EVP_MD_size(md))) {
+      ret = EVP_DigestFinal_ex(mdctx, digest.get(), nullptr);
+    } else {
+      ret = EVP_DigestFinalXOF(mdctx, digest.get(), md_len);
+    }
+    if (ret != 1) {
+      digest.reset();
+      errors.Capture();
+    }
+  }
+
+  inline void AfterThreadPoolWork() override {
+    Local<Value> args[2];
+    if (uv_error != 0) {
+      args[0] = UVException(env()->isolate(), uv_error, syscall, nullptr,
+                            path.c_str());
+      args[1] = Undefined(env()->isolate());
+    } else if (!digest) {
+      if (!errors.ToException(env()).ToLocal(&args[0])) return;
+      args[1] = Undefined(env()->isolate());
+    } else {
+      args[0] = Null(env()->isolate());
+      if (!Buffer::Copy(env(), reinterpret_cast<char*>(digest.get()), md_len)
+               .ToLocal(&args[1])) {
+        return;
+      }
+    }
+    async_wrap->MakeCallback(env()->ondone_string(), arraysize(args), args);
+  }
+};
+
+
+void HashFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString() || Buffer::HasInstance(args[0]));  // path
+  CHECK(args[1]->IsString());  // algorithm
+  CHECK(args[2]->IsUint32() || args[2]->IsUndefined());  // outputLength
+  CHECK(args[3]->IsBoolean());  // mmap
+  CHECK(args[4]->IsObject());  // wrap object
+  std::unique_ptr<HashFileJob> job(new HashFileJob(env));
+  const node::Utf8Value hash_type(env->isolate(), args[1]);
+  job->md = EVP_get_digestbyname(*hash_type);
+  if (job->md == nullptr)
+    return args.GetReturnValue().Set(-1);
+  job->md_len = EVP_MD_size(job->md);
+  if (args[2]->IsUint32()) {
+    const uint32_t xof_md_len = args[2].As<Uint32>()->Value();
+    if (xof_md_len != job->md_len &&
+        (EVP_MD_flags(job->md) & EVP_MD_FLAG_XOF) == 0) {
+      EVPerr(EVP_F_EVP_DIGESTFINALXOF, EVP_R_NOT_XOF_OR_INVALID_LENGTH);
+      return ThrowCryptoError(env, ERR_get_error(),
+                              "Digest method not supported");
+    }
+    job->md_len = xof_md_len;
+  }
+  // Buffer paths are passed through as raw bytes, like the fs bindings do.
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+  job->path = std::string(*path, path.length());
+  job->use_mmap = args[3]->IsTrue();
+  HashFileJob::Run(std::move(job), args[4]);
+}
+
+
 #ifndef OPENSSL_NO_SCRYPT
 struct ScryptJob : public CryptoJob {
   unsigned char* keybuf_data;
@@ -6894,6 +7651,11 @@ void InitCryptoOnce() {
 #endif  // !OPENSSL_NO_ENGINE
 
   NodeBIO::GetMethod();
+
+#ifndef _WIN32
+  // Random bytes cached before a fork() must not be reused by the child.
+  pthread_atfork(nullptr, nullptr, EntropyCache::OnFork);
+#endif
 }
 
 
@@ -6947,6 +7709,42 @@ void SetFipsCrypto(const FunctionCallbackInfo<Value>& args) {
 }
 #endif /* NODE_FIPS_MODE */
 
+BindingData::BindingData(Environment* env, Local<Object> obj)
+    : BaseObject(env, obj), entropy_cache(env) {}
+
+void BindingData::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("parsed_key_cache",
+                              parsed_key_cache.ByteLength());
+  tracker->TrackFieldWithSize("entropy_cache", entropy_cache.ByteLength());
+}
+
+// TODO(addaleax): Remove once we're on C++17.
+constexpr FastStringKey BindingData::type_name;
+
+static void GetParsedKeyCacheStats(const FunctionCallbackInfo<Value>& args) {
+  BindingData* data = Environment::GetBindingData<BindingData>(args);
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 3);
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+  fields[0] = data->parsed_key_cache.hits();
+  fields[1] = data->parsed_key_cache.misses();
+  fields[2] = static_cast<double>(data->parsed_key_cache.size());
+}
+
+static void GetEntropyCacheStats(const FunctionCallbackInfo<Value>& args) {
+  BindingData* data = Environment::GetBindingData<BindingData>(args);
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 3);
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+  fields[0] = data->entropy_cache.hits();
+  fields[1] = data->entropy_cache.misses();
+  fields[2] = data->entropy_cache.refills();
+}
+
 namespace {
 // SecureBuffer uses openssl to allocate a Uint8Array using
 // OPENSSL_secure_malloc. Because we do not yet actually
@@ -6985,7 +7783,12 @@ void Initialize(Local<Object> target,
   uv_once(&init_once, InitCryptoOnce);
 
   Environment* env = Environment::GetCurrent(context);
+  BindingData* const binding_data =
+      env->AddBindingData<BindingData>(context, target);
+  if (binding_data == nullptr) return;
+
   SecureContext::Initialize(env, target);
+  SNICertStore::Initialize(env, target);
   target->Set(env->context(),
             FIXED_ONE_BYTE_STRING(env->isolate(), "KeyObjectHandle"),
             KeyObjectHandle::Initialize(env)).Check();
@@ -7019,6 +7822,7 @@ void Initialize(Local<Object> target,
 #endif
 
   env->SetMethod(target, "pbkdf2", PBKDF2);
+  env->SetMethod(target, "hashFile", HashFile);
   env->SetMethod(target, "generateKeyPairRSA", GenerateKeyPairRSA);
   env->SetMethod(target, "generateKeyPairRSAPSS", GenerateKeyPairRSAPSS);
   env->SetMethod(target, "generateKeyPairDSA", GenerateKeyPairDSA);
@@ -7050,7 +7854,13 @@ void Initialize(Local<Object> target,
   env->SetMethodNoSideEffect(target, "getSSLCiphers", GetSSLCiphers);
   env->SetMethodNoSideEffect(target, "getCiphers", GetCiphers);
   env->SetMethodNoSideEffect(target, "getHashes", GetHashes);
+  env->SetMethodNoSideEffect(target, "oneShotDigest", OneShotDigest);
+  env->SetMethod(target, "oneShotDigestBatch", OneShotDigestBatch);
   env->SetMethodNoSideEffect(target, "getCurves", GetCurves);
+  env->SetMethodNoSideEffect(target, "getParsedKeyCacheStats",
+                              GetParsedKeyCacheStats);
+  env->SetMethodNoSideEffect(target, "getEntropyCacheStats",
+                              GetEntropyCacheStats);
   env->SetMethod(target, "publicEncrypt",
                  PublicKeyCipher::Cipher<PublicKeyCipher::kPublic,
                                          EVP_PKEY_encrypt_init,
@@ -42,6 +42,10 @@
 #include <openssl/ec.h>
 #include <openssl/rsa.h>
 
+#include <list>
+#include <string>
+#include <unordered_map>
+
 namespace node {
 namespace crypto {
 
@@ -86,6 +90,8 @@ extern void UseExtraCaCerts(const std::string& file);
 
 void InitCryptoOnce();
 
+class SNICertStore;
+
 class SecureContext final : public BaseObject {
  public:
   ~SecureContext() override;
@@ -102,6 +108,9 @@ class SecureContext final : public BaseObject {
   SSLCtxPointer ctx_;
   X509Pointer cert_;
   X509Pointer issuer_;
+  // Consulted natively from the servername callback before falling back to
+  // the JS `sni_context` property, see TLSWrap::SelectSNIContextCallback.
+  BaseObjectPtr<SNICertStore> sni_cert_store_;
 #ifndef OPENSSL_NO_ENGINE
   bool client_cert_engine_provided_ = false;
   std::unique_ptr<ENGINE, std::function<void(ENGINE*)>> private_key_engine_;
@@ -158,6 +167,7 @@ class SecureContext final : public BaseObject {
   static void SetTicketKeys(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetFreeListLength(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSNICertStore(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableTicketKeyCallback(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void CtxGetter(const v8::FunctionCallbackInfo<v8::Value>& info);
@@ -183,6 +193,70 @@ class SecureContext final : public BaseObject {
   void Reset();
 };
 
+// Maps SNI host names, including `*.example.com` style wildcards, to
+// certificate/key pairs that are only parsed into an SSL_CTX the first time a
+// ClientHello asks for them. Parsed contexts are kept in a bounded LRU cache,
+// so servers with many host names neither pay for all of them at startup nor
+// keep all of them in memory.
+class SNICertStore final : public BaseObject {
+ public:
+  enum StatsFields {
+    kHits,
+    kMisses,
+    kEvictions,
+    kLoadErrors,
+    kCachedContexts,
+    kStatsFieldsCount
+  };
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  // Returns the context serving `servername`, parsing and caching it if
+  // needed, or nullptr if no entry matches or the entry failed to load.
+  // The returned pointer is only valid until the next call to Lookup().
+  SSL_CTX* Lookup(const char* servername);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SNICertStore)
+  SET_SELF_SIZE(SNICertStore)
+
+  ~SNICertStore() override;
+
+ protected:
+  // Rough size of an SSL_CTX (see SecureContext) plus a certificate and key.
+  static const int64_t kExternalSize = 1024 + 4096;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Add(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Remove(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetStats(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  SNICertStore(Environment* env,
+               v8::Local<v8::Object> wrap,
+               size_t max_cached);
+
+ private:
+  struct Entry {
+    // If set, `cert` and `key` are file names rather than PEM or DER data.
+    bool from_file;
+    std::string cert;
+    std::string key;
+    std::string passphrase;
+  };
+
+  using ContextList = std::list<std::pair<std::string, SSLCtxPointer>>;
+
+  static SSLCtxPointer LoadContext(const Entry& entry);
+  void Uncache(const std::string& name);
+
+  const size_t max_cached_;
+  std::unordered_map<std::string, Entry> entries_;
+  // Most recently used contexts first.
+  ContextList contexts_;
+  std::unordered_map<std::string, ContextList::iterator> cached_;
+  double stats_[kStatsFieldsCount] = {};
+};
+
 // SSLWrap implicitly depends on the inheriting class' handle having an
 // internal pointer to the Base class.
 template <class Base>
@@ -302,6 +376,9 @@ class SSLWrap {
   CertCb cert_cb_;
   void* cert_cb_arg_;
   bool cert_cb_running_;
+  // Set when the SNICertStore of the server provided the context, in which
+  // case the JS SNICallback is not consulted.
+  bool sni_context_from_store_ = false;
 
   ClientHelloParser hello_parser_;
 
@@ -409,6 +486,86 @@ class ManagedEVPPKey {
   EVPKeyPointer pkey_;
 };
 
+// Bounded LRU cache of asymmetric keys parsed from PEM or DER strings and
+// buffers. Entries are identified by the key material itself together with
+// how it is interpreted, so that passing the same key to sign(), verify(),
+// publicEncrypt() etc. over and over does not parse it every time. Keys that
+// were given a passphrase are never cached. Only used on the thread that owns
+// the Environment.
+class ParsedKeyCache {
+ public:
+  enum KeyUsage : char {
+    kPrivateKeyOnly,
+    kPublicOrPrivateKey
+  };
+
+  static constexpr size_t kMaxEntries = 64;
+  // Larger inputs are not worth keeping around as cache keys.
+  static constexpr size_t kMaxKeyDataLength = 16 * 1024;
+
+  // A cache key. It contains the key material, so its contents are zeroed
+  // when it is deallocated.
+  class Id {
+   public:
+    Id() = default;
+    ~Id();
+    Id(const Id&) = delete;
+    Id& operator=(const Id&) = delete;
+
+    const std::string& str() const { return str_; }
+    bool empty() const { return str_.empty(); }
+
+   private:
+    friend class ParsedKeyCache;
+    std::string str_;
+  };
+
+  ParsedKeyCache() = default;
+  ~ParsedKeyCache();
+  ParsedKeyCache(const ParsedKeyCache&) = delete;
+  ParsedKeyCache& operator=(const ParsedKeyCache&) = delete;
+
+  // Computes the cache key for the given input, or returns false if the
+  // input must not be cached.
+  static bool GetId(Id* id,
+                    KeyUsage usage,
+                    const PrivateKeyEncodingConfig& config,
+                    const ByteSource& data);
+
+  // Returns an empty ManagedEVPPKey on a miss.
+  ManagedEVPPKey Get(const Id& id);
+  void Set(const Id& id, const ManagedEVPPKey& pkey);
+
+  size_t size() const { return entries_.size(); }
+  size_t ByteLength() const { return byte_length_; }
+  double hits() const { return hits_; }
+  double misses() const { return misses_; }
+
+ private:
+  using LRUList = std::list<const std::string*>;
+  struct Entry {
+    ManagedEVPPKey pkey;
+    // The full id, which contains the key material. It is kept here rather
+    // than as the map key so that it can be cleansed when the entry is
+    // removed.
+    std::string id;
+    LRUList::iterator lru_position;
+  };
+  // Maps the SHA-256 digest of an id to its entry.
+  using EntryMap = std::unordered_map<std::string, Entry>;
+
+  static std::string Digest(const std::string& id);
+
+  void Erase(EntryMap::iterator it);
+
+  EntryMap entries_;
+  // Points to the keys of `entries_`, most recently used first.
+  LRUList lru_;
+  size_t byte_length_ = 0;
+  double hits_ = 0;
+  double misses_ = 0;
+};
+
 // Objects of this class can safely be shared among threads.
 class KeyObjectData {
  public:
@@ -841,6 +998,86 @@ class ECDH final : public BaseObject {
   const EC_GROUP* group_;
 };
 
+// Buffers output of the CSPRNG so that small synchronous requests such as
+// randomBytes(16) or randomInt() can be served with a memcpy() instead of a
+// call into RAND_bytes() each. The cache is refilled one block at a time on
+// the threadpool when it runs low. Bytes are wiped as soon as they have been
+// handed out, and everything buffered before a fork() is discarded in the
+// child. Only used on the thread that owns the Environment.
+class EntropyCache {
+ public:
+  static constexpr size_t kBlockSize = 16 * 1024;
+  // Larger requests are served by RAND_bytes() directly.
+  static constexpr size_t kMaxRequestSize = 256;
+  // A refill is started once fewer than this many bytes are left.
+  static constexpr size_t kRefillThreshold = kBlockSize / 2;
+
+  explicit EntropyCache(Environment* env);
+  EntropyCache(const EntropyCache&) = delete;
+  EntropyCache& operator=(const EntropyCache&) = delete;
+
+  // Copies `size` random bytes into `data`. Returns false if the request
+  // cannot be served from the cache right now, in which case the caller
+  // should fall back to RAND_bytes().
+  bool Take(unsigned char* data, size_t size);
+
+  size_t ByteLength() const;
+  double hits() const { return hits_; }
+  double misses() const { return misses_; }
+  double refills() const { return refills_; }
+
+  // Called in the child process after fork().
+  static void OnFork();
+
+ private:
+  class RefillJob;
+  struct Block {
+    ~Block();
+    unsigned char data[kBlockSize];
+  };
+
+  void ScheduleRefill();
+  void OnRefill(std::unique_ptr<Block> block, uint32_t fork_generation);
+
+  Environment* env_;
+  // Bytes before `offset_` in `current_` have already been handed out.
+  std::unique_ptr<Block> current_;
+  size_t offset_ = kBlockSize;
+  // Filled by the last refill job and used once `current_` runs out.
+  std::unique_ptr<Block> next_;
+  bool refill_pending_ = false;
+  uint32_t fork_generation_;
+  double hits_ = 0;
+  double misses_ = 0;
+  double refills_ = 0;
+};
+
+class BindingData : public BaseObject {
+ public:
+  BindingData(Environment* env, v8::Local<v8::Object> obj);
+
+  static constexpr FastStringKey type_name{"node::crypto::BindingData"};
+
+  ParsedKeyCache parsed_key_cache;
+  EntropyCache entropy_cache;
+
+  // Looks up a digest by name, caching the result of EVP_get_digestbyname().
+  const EVP_MD* GetDigest(const char* name);
+  // Digests a string or ArrayBufferView into `md_value`, which must have room
+  // for EVP_MD_size(md) bytes, reusing a digest context across calls.
+  bool Digest(const EVP_MD* md,
+              v8::Local<v8::Value> data,
+              unsigned char* md_value);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_SELF_SIZE(BindingData)
+  SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  EVPMDPointer mdctx_;
+  std::unordered_map<std::string, const EVP_MD*> digests_;
+};
+
 bool EntropySource(unsigned char* buffer, size_t length);
 #ifndef OPENSSL_NO_ENGINE
 void SetEngine(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -27,6 +27,7 @@ using v8::EscapableHandleScope;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Isolate;
@@ -201,6 +202,15 @@ Http2Options::Http2Options(Http2State* http2_state, SessionType type) {
         option,
         static_cast<size_t>(buffer[IDX_OPTIONS_MAX_SETTINGS]));
   }
+
+  // Window auto-tuning is opt-in. If enabled, the receive windows of the
+  // session and its streams grow with the estimated bandwidth-delay product
+  // of the connection, up to the given size.
+  if (flags & (1 << IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE)) {
+    set_max_auto_tuned_window_size(
+        std::min<uint32_t>(buffer[IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE],
+                           MAX_INITIAL_WINDOW_SIZE));
+  }
 }
 
 #define GRABSETTING(entries, count, name)                                      \
@@ -446,6 +456,39 @@ void Http2Session::StopTrackingRcbuf(nghttp2_rcbuf* buf) {
   StopTrackingMemory(buf);
 }
 
+MaybeLocal<String> Http2Session::GetHeaderString(
+    const Http2RcBufferPointer& buf) {
+  // Static table entries already map to eternal strings.
+  if (buf.IsStatic() || buf.len() == 0)
+    return Http2RcBufferPointer::External::New(this, buf);
+
+  auto it = header_strings_.find(buf.get());
+  if (it != header_strings_.end())
+    return it->second.str.Get(env()->isolate());
+
+  Local<String> str;
+  if (!Http2RcBufferPointer::External::New(this, buf).ToLocal(&str))
+    return MaybeLocal<String>();
+
+  // Account for entries the same way HPACK does, i.e. with an overhead of
+  // 32 bytes each. Rather than tracking which entries were evicted from the
+  // peer's table, start over once the cache is full.
+  size_t size = buf.len() + 32;
+  size_t max_size = nghttp2_session_get_local_settings(
+      session_.get(), NGHTTP2_SETTINGS_HEADER_TABLE_SIZE);
+  if (header_strings_size_ + size > max_size) {
+    header_strings_.clear();
+    header_strings_size_ = 0;
+    if (size > max_size)
+      return str;
+  }
+  header_strings_.emplace(
+      buf.get(),
+      CachedHeaderString { buf, Global<String>(env()->isolate(), str) });
+  header_strings_size_ += size;
+  return str;
+}
+
 void Http2Session::CheckAllocatedSize(size_t previous_size) const {
   CHECK_GE(current_nghttp2_memory_, previous_size);
 }
@@ -472,6 +515,7 @@ Http2Session::Http2Session(Http2State* http2_state,
   Http2Options opts(http2_state, type);
 
   max_session_memory_ = opts.max_session_memory();
+  max_auto_tuned_window_size_ = opts.max_auto_tuned_window_size();
 
   uint32_t maxHeaderPairs = opts.max_header_pairs();
   max_header_pairs_ =
@@ -519,7 +563,9 @@ Http2Session::~Http2Session() {
   CHECK(!is_in_scope());
   Debug(this, "freeing nghttp2 session");
   // Explicitly reset session_ so the subsequent
-  // current_nghttp2_memory_ check passes.
+  // current_nghttp2_memory_ check passes. The cached header strings hold
+  // references to rcbufs allocated by the session, so drop them first.
+  header_strings_.clear();
   session_.reset();
   CHECK_EQ(current_nghttp2_memory_, 0);
 }
@@ -534,6 +580,7 @@ void Http2Session::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("pending_rst_streams",
                               pending_rst_streams_.size() * sizeof(int32_t));
   tracker->TrackFieldWithSize("nghttp2_memory", current_nghttp2_memory_);
+  tracker->TrackFieldWithSize("header_strings", header_strings_size_);
 }
 
 std::string Http2Session::diagnostic_name() const {
@@ -604,6 +651,10 @@ void Http2Session::EmitStatistics() {
         static_cast<double>(entry->data_received());
     buffer[IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS] =
         static_cast<double>(entry->max_concurrent_streams());
+    buffer[IDX_SESSION_STATS_WINDOW_SIZE_UPDATES] =
+        entry->window_size_updates();
+    buffer[IDX_SESSION_STATS_AUTO_TUNED_WINDOW_SIZE] =
+        entry->auto_tuned_window_size();
     Local<Object> obj;
     if (entry->ToObject().ToLocal(&obj)) entry->Notify(obj);
   });
@@ -1043,6 +1094,8 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
   // so that it can send a WINDOW_UPDATE frame. This is a critical part of
   // the flow control process in http2
   CHECK_EQ(nghttp2_session_consume_connection(handle, len), 0);
+  if (session->max_auto_tuned_window_size_ != 0)
+    session->SampleBdp(len);
   BaseObjectPtr<Http2Stream> stream = session->FindStream(id);
 
   // If the stream has been destroyed, ignore this chunk
@@ -1051,6 +1104,15 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
 
   stream->statistics_.received_bytes += len;
 
+  // Streams that were opened before the auto-tuned window size was last
+  // increased are updated the next time they receive data.
+  if (session->auto_tuned_window_size_ != 0 &&
+      nghttp2_session_get_stream_effective_local_window_size(handle, id) <
+          static_cast<int32_t>(session->auto_tuned_window_size_)) {
+    nghttp2_session_set_local_window_size(
+        handle, NGHTTP2_FLAG_NONE, id, session->auto_tuned_window_size_);
+  }
+
   // Repeatedly ask the stream's owner for memory, and copy the read data
   // into those buffers.
   // The typical case is actually the exception here; Http2StreamListeners
@@ -1221,10 +1283,18 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
   size_t sensitive_count = 0;
 
   stream->TransferHeaders([&](const Http2Header& header, size_t i) {
-    headers_v[i * 2] = header.GetName(this).ToLocalChecked();
-    headers_v[i * 2 + 1] = header.GetValue(this).ToLocalChecked();
-    if (header.flags() & NGHTTP2_NV_FLAG_NO_INDEX)
+    // Sensitive headers are never indexed by the peer, and should not be
+    // kept around any longer than necessary either.
+    if (header.flags() & NGHTTP2_NV_FLAG_NO_INDEX) {
+      headers_v[i * 2] = header.GetName(this).ToLocalChecked();
+      headers_v[i * 2 + 1] = header.GetValue(this).ToLocalChecked();
       sensitive_v[sensitive_count++] = headers_v[i * 2];
+      return;
+    }
+    headers_v[i * 2] =
+        GetHeaderString(header.name_buffer()).ToLocalChecked();
+    headers_v[i * 2 + 1] =
+        GetHeaderString(header.value_buffer()).ToLocalChecked();
   });
   CHECK_EQ(stream->headers_count(), 0);
 
@@ -1380,6 +1450,14 @@ void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   Local<Value> arg;
   bool ack = frame->hd.flags & NGHTTP2_FLAG_ACK;
   if (ack) {
+    if (bdp_ping_in_flight_ &&
+        memcmp(frame->ping.opaque_data,
+               bdp_ping_payload_,
+               sizeof(bdp_ping_payload_)) == 0) {
+      OnBdpPingAck();
+      return;
+    }
+
     BaseObjectPtr<Http2Ping> ping = PopPing();
 
     if (!ping) {
@@ -1406,6 +1484,73 @@ void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   MakeCallback(env()->http2session_on_ping_function(), 1, &arg);
 }
 
+// Called for every chunk of DATA received while window auto-tuning is
+// enabled. Starts a new bandwidth-delay product sample by sending a PING
+// frame if none is in flight, unless the window cannot grow any further or
+// the previous samples suggest that it does not need to.
+void Http2Session::SampleBdp(size_t length) {
+  bdp_sample_ += length;
+  if (bdp_ping_in_flight_ ||
+      auto_tuned_window_size_ >= max_auto_tuned_window_size_) {
+    return;
+  }
+  uint64_t now = uv_hrtime();
+  if (now < bdp_next_ping_)
+    return;
+  static_assert(sizeof(now) == sizeof(bdp_ping_payload_),
+                "PING payloads are 8 bytes long");
+  memcpy(bdp_ping_payload_, &now, sizeof(now));
+  if (nghttp2_submit_ping(session_.get(),
+                          NGHTTP2_FLAG_NONE,
+                          bdp_ping_payload_) != 0) {
+    return;
+  }
+  Debug(this, "sending bdp ping");
+  bdp_ping_in_flight_ = true;
+  bdp_ping_sent_ = now;
+}
+
+// Called when the PING started by SampleBdp() is acknowledged. Similar to
+// gRPC, the window is doubled if the peer managed to send at least two thirds
+// of the current window during the round trip, and the bandwidth measured
+// is the highest one so far. Otherwise, sampling backs off.
+void Http2Session::OnBdpPingAck() {
+  uint64_t now = uv_hrtime();
+  uint64_t sample = bdp_sample_;
+  double rtt = std::max<uint64_t>(now - bdp_ping_sent_, 1) / 1e9;
+  double bandwidth = sample / rtt;
+  bdp_ping_in_flight_ = false;
+  bdp_sample_ = 0;
+
+  uint32_t window = std::max<uint32_t>(
+      auto_tuned_window_size_,
+      nghttp2_session_get_effective_local_window_size(session_.get()));
+  uint64_t target = std::min<uint64_t>(sample * 2, max_auto_tuned_window_size_);
+  Debug(this, "bdp sample: %d bytes, rtt: %s s, window: %d",
+        sample, rtt, window);
+
+  if (sample * 3 < static_cast<uint64_t>(window) * 2 ||
+      bandwidth <= bdp_max_bandwidth_ ||
+      target <= window ||
+      !has_available_session_memory(target - window)) {
+    bdp_ping_delay_ = bdp_ping_delay_ == 0 ?
+        kMinBdpPingDelay : std::min(bdp_ping_delay_ * 2, kMaxBdpPingDelay);
+    bdp_next_ping_ = now + bdp_ping_delay_;
+    return;
+  }
+
+  int rv = nghttp2_session_set_local_window_size(
+      session_.get(), NGHTTP2_FLAG_NONE, 0, static_cast<int32_t>(target));
+  if (rv != 0)
+    return;
+  Debug(this, "auto-tuned window size: %d", target);
+  bdp_max_bandwidth_ = bandwidth;
+  bdp_ping_delay_ = 0;
+  auto_tuned_window_size_ = static_cast<uint32_t>(target);
+  statistics_.window_size_updates++;
+  statistics_.auto_tuned_window_size = auto_tuned_window_size_;
+}
+
 // Called by OnFrameReceived when a complete SETTINGS frame has been received.
 void Http2Session::HandleSettingsFrame(const nghttp2_frame* frame) {
   bool ack = frame->hd.flags & NGHTTP2_FLAG_ACK;
@@ -1566,9 +1711,20 @@ void Http2Session::PushOutgoingBuffer(NgHttp2StreamWrite&& write) {
 // so it is used for the cases in which nghttp2 requests sending of a
 // small chunk of data.
 void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
-  size_t offset = outgoing_storage_.size();
-  outgoing_storage_.resize(offset + src_length);
-  memcpy(&outgoing_storage_[offset], src, src_length);
+  outgoing_storage_.insert(outgoing_storage_.end(), src, src + src_length);
+
+  // Consecutive copies end up next to each other in outgoing_storage_, so
+  // they can be written as a single buffer. This keeps the number of buffers
+  // that are passed to the underlying stream low when many small frames, or
+  // frame headers of DATA frames without payload, are sent.
+  if (!outgoing_buffers_.empty()) {
+    NgHttp2StreamWrite& last = outgoing_buffers_.back();
+    if (last.buf.base == nullptr && !last.req_wrap) {
+      last.buf.len += src_length;
+      outgoing_length_ += src_length;
+      return;
+    }
+  }
 
   // Store with a base of `nullptr` initially, since future resizes
   // of the outgoing_buffers_ vector may invalidate the pointer.
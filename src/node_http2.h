@@ -38,6 +38,12 @@ constexpr size_t kDefaultMaxSettings = 10;
 // Default maximum total memory cap for Http2Session.
 constexpr uint64_t kDefaultMaxSessionMemory = 10000000;
 
+// When window auto-tuning is enabled and a bandwidth-delay product sample
+// did not lead to a larger window, the next sample is delayed, starting with
+// kMinBdpPingDelay and doubling up to kMaxBdpPingDelay (in nanoseconds).
+constexpr uint64_t kMinBdpPingDelay = 100 * 1000 * 1000;
+constexpr uint64_t kMaxBdpPingDelay = 10ull * 1000 * 1000 * 1000;
+
 // These are the standard HTTP/2 defaults as specified by the RFC
 constexpr uint32_t DEFAULT_SETTINGS_HEADER_TABLE_SIZE = 4096;
 constexpr uint32_t DEFAULT_SETTINGS_ENABLE_PUSH = 1;
@@ -233,9 +239,18 @@ class Http2Options {
     return max_session_memory_;
   }
 
+  void set_max_auto_tuned_window_size(uint32_t max) {
+    max_auto_tuned_window_size_ = max;
+  }
+
+  uint32_t max_auto_tuned_window_size() const {
+    return max_auto_tuned_window_size_;
+  }
+
  private:
   Nghttp2OptionPointer options_;
   uint64_t max_session_memory_ = kDefaultMaxSessionMemory;
+  uint32_t max_auto_tuned_window_size_ = 0;
   uint32_t max_header_pairs_ = DEFAULT_MAX_HEADER_LIST_PAIRS;
   PaddingStrategy padding_strategy_ = PADDING_STRATEGY_NONE;
   size_t max_outstanding_pings_ = kDefaultMaxPings;
@@ -736,6 +751,10 @@ class Http2Session : public AsyncWrap,
   // this session now, and may outlive it.
   void StopTrackingRcbuf(nghttp2_rcbuf* buf);
 
+  // Returns the JS string for a received header name or value, reusing the
+  // string created earlier for the same HPACK dynamic table entry.
+  v8::MaybeLocal<v8::String> GetHeaderString(const Http2RcBufferPointer& buf);
+
   // Returns the current session memory including memory allocated by nghttp2,
   // the current outbound storage queue, and pending writes.
   uint64_t current_session_memory() const {
@@ -761,6 +780,8 @@ class Http2Session : public AsyncWrap,
     int32_t stream_count;
     size_t max_concurrent_streams;
     double stream_average_duration;
+    uint32_t window_size_updates;
+    uint32_t auto_tuned_window_size;
   };
 
   Statistics statistics_ = {};
@@ -768,6 +789,10 @@ class Http2Session : public AsyncWrap,
  private:
   void EmitStatistics();
 
+  // Window auto-tuning
+  void SampleBdp(size_t length);
+  void OnBdpPingAck();
+
   // Frame Padding Strategies
   ssize_t OnDWordAlignedPadding(size_t frameLength,
                                 size_t maxPayloadLen);
@@ -899,6 +924,33 @@ class Http2Session : public AsyncWrap,
   size_t max_outstanding_pings_ = kDefaultMaxPings;
   std::queue<BaseObjectPtr<Http2Ping>> outstanding_pings_;
 
+  // Strings created for header names and values, keyed by the rcbuf they
+  // were created from. Header fields taken from the HPACK dynamic table share
+  // the rcbuf of the table entry, so headers that repeat across streams are
+  // only converted once. Each entry holds a reference to its rcbuf, so its
+  // address cannot be reused while it is cached. The total size is bounded
+  // by the HPACK table size that we advertise to the peer.
+  struct CachedHeaderString {
+    Http2RcBufferPointer buf;
+    v8::Global<v8::String> str;
+  };
+  std::unordered_map<nghttp2_rcbuf*, CachedHeaderString> header_strings_;
+  size_t header_strings_size_ = 0;
+
+  // Window auto-tuning is disabled if max_auto_tuned_window_size_ is 0.
+  // Otherwise, the DATA received between two acknowledgements of an internal
+  // PING is used as a sample of the bandwidth-delay product of the
+  // connection, and the receive windows are grown to match it.
+  uint32_t max_auto_tuned_window_size_ = 0;
+  uint32_t auto_tuned_window_size_ = 0;
+  bool bdp_ping_in_flight_ = false;
+  uint8_t bdp_ping_payload_[8] = {};
+  uint64_t bdp_ping_sent_ = 0;
+  uint64_t bdp_ping_delay_ = 0;
+  uint64_t bdp_next_ping_ = 0;
+  uint64_t bdp_sample_ = 0;
+  double bdp_max_bandwidth_ = 0;
+
   size_t max_outstanding_settings_ = kDefaultMaxSettings;
   std::queue<BaseObjectPtr<Http2Settings>> outstanding_settings_;
 
@@ -943,6 +995,8 @@ class Http2SessionPerformanceEntry : public performance::PerformanceEntry {
           stream_count_(stats.stream_count),
           max_concurrent_streams_(stats.max_concurrent_streams),
           stream_average_duration_(stats.stream_average_duration),
+          window_size_updates_(stats.window_size_updates),
+          auto_tuned_window_size_(stats.auto_tuned_window_size),
           session_type_(type),
           http2_state_(http2_state) { }
 
@@ -954,6 +1008,8 @@ class Http2SessionPerformanceEntry : public performance::PerformanceEntry {
   int32_t stream_count() const { return stream_count_; }
   size_t max_concurrent_streams() const { return max_concurrent_streams_; }
   double stream_average_duration() const { return stream_average_duration_; }
+  uint32_t window_size_updates() const { return window_size_updates_; }
+  uint32_t auto_tuned_window_size() const { return auto_tuned_window_size_; }
   SessionType type() const { return session_type_; }
   Http2State* http2_state() const { return http2_state_.get(); }
 
@@ -970,6 +1026,8 @@ class Http2SessionPerformanceEntry : public performance::PerformanceEntry {
   int32_t stream_count_;
   size_t max_concurrent_streams_;
   double stream_average_duration_;
+  uint32_t window_size_updates_;
+  uint32_t auto_tuned_window_size_;
   SessionType session_type_;
   BaseObjectPtr<Http2State> http2_state_;
 };
@@ -55,6 +55,7 @@ namespace http2 {
     IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS,
     IDX_OPTIONS_MAX_SESSION_MEMORY,
     IDX_OPTIONS_MAX_SETTINGS,
+    IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE,
     IDX_OPTIONS_FLAGS
   };
 
@@ -78,6 +79,8 @@ namespace http2 {
     IDX_SESSION_STATS_DATA_SENT,
     IDX_SESSION_STATS_DATA_RECEIVED,
     IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS,
+    IDX_SESSION_STATS_WINDOW_SIZE_UPDATES,
+    IDX_SESSION_STATS_AUTO_TUNED_WINDOW_SIZE,
     IDX_SESSION_STATS_COUNT
   };
 
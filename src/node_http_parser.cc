@@ -21,17 +21,27 @@
 
 #include "node.h"
 #include "node_buffer.h"
+#include "node_errors.h"
+#include "node_mutex.h"
 #include "util.h"
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
 #include "stream_base-inl.h"
+#include "timer_wrap.h"
 #include "v8.h"
 #include "llhttp.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>  // snprintf()
 #include <cstdlib>  // free()
 #include <cstring>  // strdup(), strchr()
+#include <ctime>  // time()
+#include <memory>
+#include <string>
+#include <vector>
 
 
 // This is a binding to llhttp (https://github.com/nodejs/llhttp)
@@ -50,6 +60,8 @@ namespace node {
 namespace {  // NOLINT(build/namespaces)
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -57,11 +69,14 @@ using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Number;
 using v8::Object;
 using v8::String;
@@ -76,6 +91,8 @@ const uint32_t kOnBody = 3;
 const uint32_t kOnMessageComplete = 4;
 const uint32_t kOnExecute = 5;
 const uint32_t kOnTimeout = 6;
+const uint32_t kOnEvents = 7;
+const uint32_t kOnKeepAliveTimeout = 8;
 // Any more fields than this will be flushed into JS
 const size_t kMaxHeaderFieldsCount = 32;
 
@@ -83,26 +100,654 @@ inline bool IsOWS(char c) {
   return c == ' ' || c == '\t';
 }
 
+// Well-known header names, lowercased. A header whose name matches one of
+// these case-insensitively is reported to JS with the index of the name plus
+// one in `headerNameIds`, so that _http_incoming.js does not need to compare
+// and lowercase it again.
+const char* const kKnownHeaderNames[] = {
+  "accept",
+  "accept-encoding",
+  "accept-language",
+  "accept-ranges",
+  "access-control-request-headers",
+  "access-control-request-method",
+  "age",
+  "authorization",
+  "cache-control",
+  "connection",
+  "content-encoding",
+  "content-language",
+  "content-length",
+  "content-range",
+  "content-type",
+  "cookie",
+  "date",
+  "dnt",
+  "etag",
+  "expect",
+  "expires",
+  "forwarded",
+  "from",
+  "host",
+  "if-match",
+  "if-modified-since",
+  "if-none-match",
+  "if-range",
+  "if-unmodified-since",
+  "keep-alive",
+  "last-modified",
+  "location",
+  "max-forwards",
+  "origin",
+  "pragma",
+  "proxy-authorization",
+  "range",
+  "referer",
+  "retry-after",
+  "sec-websocket-extensions",
+  "sec-websocket-key",
+  "sec-websocket-protocol",
+  "sec-websocket-version",
+  "server",
+  "set-cookie",
+  "te",
+  "transfer-encoding",
+  "upgrade",
+  "upgrade-insecure-requests",
+  "user-agent",
+  "vary",
+  "via",
+  "x-forwarded-for",
+  "x-forwarded-host",
+  "x-forwarded-proto",
+  "x-real-ip",
+  "x-request-id",
+  "x-requested-with",
+};
+
+// Frequent header values. These are matched case-sensitively, because values
+// are passed to JS as they were received.
+const char* const kKnownHeaderValues[] = {
+  "*/*",
+  "0",
+  "100-continue",
+  "application/json",
+  "application/octet-stream",
+  "application/x-www-form-urlencoded",
+  "br",
+  "chunked",
+  "close",
+  "deflate",
+  "gzip",
+  "gzip, deflate",
+  "gzip, deflate, br",
+  "identity",
+  "keep-alive",
+  "Keep-Alive",
+  "max-age=0",
+  "no-cache",
+  "text/html",
+  "text/plain",
+  "Upgrade",
+  "websocket",
+};
+
+constexpr size_t kMaxKnownHeaderLength = 40;
+
+// Characters that are allowed in the names and values of outgoing headers.
+// These match checkIsHttpToken() and checkInvalidHeaderChar() in
+// lib/_http_common.js.
+struct HeaderCharTable {
+  constexpr HeaderCharTable() : token(), value() {
+    for (int c = 0; c < 256; c++) {
+      token[c] = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') ||
+                 (c >= 'a' && c <= 'z') || c == '!' || c == '#' ||
+                 c == '$' || c == '%' || c == '&' || c == '\'' ||
+                 c == '*' || c == '+' || c == '-' || c == '.' ||
+                 c == '^' || c == '_' || c == '`' || c == '|' || c == '~';
+      value[c] = c == '\t' || (c >= 0x20 && c != 0x7f);
+    }
+  }
+
+  bool token[256];
+  bool value[256];
+};
+
+constexpr HeaderCharTable kHeaderChars;
+
+// What serializeHeaders() has found out about the special headers of an
+// outgoing message. Keep in sync with lib/_http_outgoing.js.
+enum OutgoingHeaderStateFields {
+  kHasConnection,
+  kConnectionClose,
+  kConnectionKeepAlive,
+  kHasContentLength,
+  kHasTransferEncoding,
+  kChunked,
+  kHasDate,
+  kHasExpect,
+  kHasTrailer,
+  kHasKeepAlive,
+  kOutgoingHeaderStateFieldsCount
+};
+
+// Length of a date in the format of Date.prototype.toUTCString(), e.g.
+// "Sun, 06 Nov 1994 08:49:37 GMT", without the terminating NUL.
+constexpr size_t kUTCDateLength = 29;
+
+// Formats `time`, in seconds since the epoch, like toUTCString() does for
+// the years 1970 to 9999. `buf` needs room for kUTCDateLength + 1 bytes.
+void FormatUTCDate(uint64_t time, char* buf) {
+  static const char* const kDays[] = {
+    "Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"
+  };
+  static const char* const kMonths[] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+  };
+
+  const uint64_t days = time / 86400;
+  const unsigned seconds = time % 86400;
+
+  // Convert the number of days to a civil date, see
+  // http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+  const uint64_t z = days + 719468;
+  const uint64_t era = z / 146097;
+  const unsigned doe = static_cast<unsigned>(z - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+  const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+  const unsigned year =
+      static_cast<unsigned>(yoe + era * 400) + (month <= 2 ? 1 : 0);
+
+  snprintf(buf, kUTCDateLength + 1, "%s, %02u %s %04u %02u:%02u:%02u GMT",
+           kDays[days % 7], day, kMonths[month - 1], year,
+           seconds / 3600, seconds / 60 % 60, seconds % 60);
+}
+
+// Fixed-size buffers that consumed sockets read into. A buffer that body
+// chunks are handed out from is shared with JS through an ArrayBuffer, which
+// holds a reference to it, so that parserOnBody() gets slices of the data as
+// it was read instead of a copy. Buffers go back to the pool once the last
+// reference is gone. Since ArrayBuffer contents may be released on any
+// thread, the pool is thread-safe and kept alive by every outstanding buffer.
+class ReadBufferPool : public std::enable_shared_from_this<ReadBufferPool> {
+ public:
+  static constexpr size_t kBufferSize = 64 * 1024;
+  // Upper bound for the number of unused buffers that are kept around.
+  static constexpr size_t kMaxFreeBuffers = 8;
+
+  ReadBufferPool() = default;
+  ReadBufferPool(const ReadBufferPool&) = delete;
+  ReadBufferPool& operator=(const ReadBufferPool&) = delete;
+
+  ~ReadBufferPool() {
+    for (Chunk* chunk : free_)
+      delete chunk;
+  }
+
+  // Returns a buffer of kBufferSize bytes with one reference.
+  char* Acquire() {
+    Chunk* chunk = nullptr;
+    {
+      Mutex::ScopedLock lock(mutex_);
+      if (!free_.empty()) {
+        chunk = free_.back();
+        free_.pop_back();
+      }
+    }
+    if (chunk == nullptr)
+      chunk = new Chunk;
+    chunk->refs = 1;
+    return chunk->data;
+  }
+
+  void Unref(char* data) {
+    if (data == nullptr)
+      return;
+    Chunk* chunk = reinterpret_cast<Chunk*>(data);
+    if (--chunk->refs != 0)
+      return;
+    Mutex::ScopedLock lock(mutex_);
+    if (free_.size() < kMaxFreeBuffers)
+      free_.push_back(chunk);
+    else
+      delete chunk;
+  }
+
+  // Creates an ArrayBuffer for the first `length` bytes of `data`, which
+  // must have been returned by Acquire(), and takes a reference for it.
+  Local<ArrayBuffer> ToArrayBuffer(Isolate* isolate,
+                                   char* data,
+                                   size_t length) {
+    CHECK_LE(length, kBufferSize);
+    reinterpret_cast<Chunk*>(data)->refs++;
+    std::unique_ptr<BackingStore> bs = ArrayBuffer::NewBackingStore(
+        data, length,
+        [](void* data, size_t length, void* deleter_data) {
+          std::unique_ptr<std::shared_ptr<ReadBufferPool>> pool(
+              static_cast<std::shared_ptr<ReadBufferPool>*>(deleter_data));
+          (*pool)->Unref(static_cast<char*>(data));
+        },
+        new std::shared_ptr<ReadBufferPool>(shared_from_this()));
+    return ArrayBuffer::New(isolate, std::move(bs));
+  }
+
+  size_t ByteLength() {
+    Mutex::ScopedLock lock(mutex_);
+    return free_.size() * sizeof(Chunk);
+  }
+
+ private:
+  struct Chunk {
+    // Must be the first member, see Unref().
+    char data[kBufferSize];
+    std::atomic<uint32_t> refs{0};
+  };
+
+  Mutex mutex_;
+  std::vector<Chunk*> free_;
+};
+
+class Parser;
+
+// A deadline that a parser has registered with the ConnectionTimeoutWheel.
+struct ConnectionTimeout {
+  explicit ConnectionTimeout(Parser* parser, uint32_t callback)
+      : parser(parser), callback(callback) {}
+
+  ListNode<ConnectionTimeout> wheel_node;
+  Parser* const parser;
+  // The index of the parser callback to call once the deadline has passed.
+  const uint32_t callback;
+  // In ticks of the ConnectionTimeoutWheel.
+  uint64_t deadline = 0;
+};
+
+// Keeps the headers and keep-alive deadlines of all HTTP server connections
+// of an Environment in a hierarchical timing wheel. Arming and cancelling a
+// deadline does not involve JS timers, there is a single libuv timer that
+// only runs while deadlines are pending, and only connections that actually
+// time out are reported to JS. Deadlines are rounded up to whole ticks.
+class ConnectionTimeoutWheel : public MemoryRetainer {
+ public:
+  static constexpr uint64_t kTickMs = 100;
+
+  explicit ConnectionTimeoutWheel(Environment* env)
+      : env_(env), timer_(env, [this]() { OnTick(); }) {
+    timer_.Unref();
+  }
+
+  void Schedule(ConnectionTimeout* timeout, uint64_t ms) {
+    timeout->wheel_node.Remove();
+    const uint64_t now = uv_now(env_->event_loop());
+    if (!running_) {
+      current_tick_ = now / kTickMs;
+      timer_.Update(kTickMs, kTickMs);
+      running_ = true;
+    }
+    timeout->deadline = (now + ms + kTickMs - 1) / kTickMs;
+    if (timeout->deadline <= current_tick_)
+      timeout->deadline = current_tick_ + 1;
+    Insert(timeout);
+  }
+
+  static void Cancel(ConnectionTimeout* timeout) {
+    timeout->wheel_node.Remove();
+  }
+
+  bool IsEmpty() const {
+    for (const auto& level : slots_) {
+      for (const Slot& slot : level) {
+        if (!slot.IsEmpty())
+          return false;
+      }
+    }
+    return true;
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("timer", timer_);
+  }
+  SET_MEMORY_INFO_NAME(ConnectionTimeoutWheel)
+  SET_SELF_SIZE(ConnectionTimeoutWheel)
+
+ private:
+  // Each level has 64 slots, and each slot of a level covers as many ticks
+  // as the whole level below it. Deadlines beyond the last level are put
+  // into it and moved again once they get there.
+  static constexpr unsigned kLevelBits = 6;
+  static constexpr uint64_t kSlotMask = (1 << kLevelBits) - 1;
+  static constexpr size_t kLevels = 3;
+  static constexpr uint64_t kMaxDelta = (1 << (kLevelBits * kLevels)) - 1;
+
+  using Slot = ListHead<ConnectionTimeout, &ConnectionTimeout::wheel_node>;
+
+  void Insert(ConnectionTimeout* timeout) {
+    uint64_t deadline = timeout->deadline;
+    uint64_t delta = deadline > current_tick_ ? deadline - current_tick_ : 0;
+    if (delta > kMaxDelta) {
+      delta = kMaxDelta;
+      deadline = current_tick_ + kMaxDelta;
+    }
+    size_t level = 0;
+    while (level + 1 < kLevels && delta >> (kLevelBits * (level + 1)) != 0)
+      level++;
+    slots_[level][(deadline >> (kLevelBits * level)) & kSlotMask]
+        .PushBack(timeout);
+  }
+
+  // Moves the deadlines of a slot of a higher level to the levels below.
+  void Cascade(size_t level) {
+    Slot& slot =
+        slots_[level][(current_tick_ >> (kLevelBits * level)) & kSlotMask];
+    while (ConnectionTimeout* timeout = slot.PopFront())
+      Insert(timeout);
+  }
+
+  // Defined after Parser.
+  inline void OnTick();
+
+  Environment* env_;
+  TimerWrapHandle timer_;
+  bool running_ = false;
+  uint64_t current_tick_ = 0;
+  Slot slots_[kLevels][1 << kLevelBits];
+};
+
 class BindingData : public BaseObject {
  public:
   BindingData(Environment* env, Local<Object> obj)
-      : BaseObject(env, obj) {}
+      : BaseObject(env, obj),
+        connection_timeouts(env),
+        read_buffer_pool(std::make_shared<ReadBufferPool>()),
+        header_name_ids(env->isolate(), kMaxHeaderFieldsCount),
+        outgoing_header_state(env->isolate(),
+                              kOutgoingHeaderStateFieldsCount) {
+    static_assert(arraysize(kKnownHeaderNames) < 256,
+                  "Header name ids must fit into a uint8_t");
+    Isolate* isolate = env->isolate();
+    for (size_t i = 0; i < arraysize(kKnownHeaderNames); i++) {
+      const char* name = kKnownHeaderNames[i];
+      const size_t length = strlen(name);
+      CHECK_LE(length, kMaxKnownHeaderLength);
+      known_names_by_length_[length].push_back(i);
+      // Besides the lowercase spelling, also keep the one that is used by
+      // most clients, e.g. Content-Type.
+      std::string title_case(name);
+      for (size_t j = 0; j < length; j++) {
+        if (j == 0 || title_case[j - 1] == '-')
+          title_case[j] = ToUpper(title_case[j]);
+      }
+      known_names_.emplace_back(isolate, Internalize(name, length));
+      known_names_.emplace_back(
+          isolate, Internalize(title_case.data(), length));
+      title_case_names_.emplace_back(std::move(title_case));
+    }
+    for (size_t i = 0; i < arraysize(kKnownHeaderValues); i++) {
+      const char* value = kKnownHeaderValues[i];
+      const size_t length = strlen(value);
+      CHECK_LE(length, kMaxKnownHeaderLength);
+      known_values_by_length_[length].push_back(i);
+      known_values_.emplace_back(isolate, Internalize(value, length));
+    }
+  }
 
   static constexpr FastStringKey type_name { "http_parser" };
 
-  std::vector<char> parser_buffer;
-  bool parser_buffer_in_use = false;
+  ConnectionTimeoutWheel connection_timeouts;
+  std::shared_ptr<ReadBufferPool> read_buffer_pool;
+  // Filled in by Parser::CreateHeaders(), one entry per header name.
+  AliasedUint8Array header_name_ids;
+  // Filled in by SerializeHeaders(), see OutgoingHeaderStateFields.
+  AliasedUint8Array outgoing_header_state;
+
+  // Returns the current time formatted for the Date header. The value is
+  // formatted at most once per second.
+  const char* UTCDate() {
+    const time_t now = time(nullptr);
+    if (now != date_time_) {
+      FormatUTCDate(now, date_);
+      date_time_ = now;
+      date_string_.Reset();
+    }
+    return date_;
+  }
+
+  Local<String> UTCDateString() {
+    const char* date = UTCDate();
+    if (date_string_.IsEmpty()) {
+      date_string_.Reset(env()->isolate(),
+                         OneByteString(env()->isolate(), date,
+                                       kUTCDateLength));
+    }
+    return date_string_.Get(env()->isolate());
+  }
+
+  // Returns the id of a well-known header name, or 0. If the name is spelled
+  // exactly as one of the cached strings, that string is stored in `*str`.
+  uint8_t LookupHeaderName(const char* data, size_t size, Local<String>* str) {
+    if (size > kMaxKnownHeaderLength)
+      return 0;
+    for (size_t i : known_names_by_length_[size]) {
+      const char* name = kKnownHeaderNames[i];
+      if (!StringEqualNoCaseN(data, name, size))
+        continue;
+      if (memcmp(data, name, size) == 0)
+        *str = known_names_[i * 2].Get(env()->isolate());
+      else if (memcmp(data, title_case_names_[i].data(), size) == 0)
+        *str = known_names_[i * 2 + 1].Get(env()->isolate());
+      return static_cast<uint8_t>(i + 1);
+    }
+    return 0;
+  }
+
+  // Returns a cached string for well-known header values, or an empty handle.
+  Local<String> LookupHeaderValue(const char* data, size_t size) {
+    if (size > kMaxKnownHeaderLength)
+      return Local<String>();
+    for (size_t i : known_values_by_length_[size]) {
+      if (memcmp(data, kKnownHeaderValues[i], size) == 0)
+        return known_values_[i].Get(env()->isolate());
+    }
+    return Local<String>();
+  }
 
   void MemoryInfo(MemoryTracker* tracker) const override {
-    tracker->TrackField("parser_buffer", parser_buffer);
+    tracker->TrackField("connection_timeouts", connection_timeouts);
+    tracker->TrackFieldWithSize("read_buffer_pool",
+                                read_buffer_pool->ByteLength());
+    tracker->TrackField("header_name_ids", header_name_ids);
+    tracker->TrackField("outgoing_header_state", outgoing_header_state);
+    tracker->TrackField("date_string", date_string_);
   }
   SET_SELF_SIZE(BindingData)
   SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  Local<String> Internalize(const char* data, size_t length) {
+    return String::NewFromOneByte(env()->isolate(),
+                                  reinterpret_cast<const uint8_t*>(data),
+                                  NewStringType::kInternalized,
+                                  length).ToLocalChecked();
+  }
+
+  // Lowercase and title case spelling of each name in kKnownHeaderNames.
+  std::vector<Global<String>> known_names_;
+  std::vector<std::string> title_case_names_;
+  std::vector<Global<String>> known_values_;
+  std::vector<size_t> known_names_by_length_[kMaxKnownHeaderLength + 1];
+  std::vector<size_t> known_values_by_length_[kMaxKnownHeaderLength + 1];
+  time_t date_time_ = 0;
+  char date_[kUTCDateLength + 1];
+  Global<String> date_string_;
 };
 
 // TODO(addaleax): Remove once we're on C++17.
 constexpr FastStringKey BindingData::type_name;
 
+// Appends the Latin-1 contents of `str` to `out`. If `allowed` is given,
+// returns false when `str` contains a character that it does not allow.
+bool AppendHeaderString(Isolate* isolate,
+                        std::string* out,
+                        Local<String> str,
+                        const bool* allowed) {
+  const int length = str->Length();
+  if (allowed != nullptr && !str->IsOneByte() && !str->ContainsOnlyOneByte())
+    return false;
+  const size_t offset = out->size();
+  out->resize(offset + length);
+  uint8_t* const data = reinterpret_cast<uint8_t*>(&(*out)[offset]);
+  str->WriteOneByte(isolate, data, 0, length, String::NO_NULL_TERMINATION);
+  if (allowed != nullptr) {
+    for (int i = 0; i < length; i++) {
+      if (!allowed[data[i]])
+        return false;
+    }
+  }
+  return true;
+}
+
+inline bool IsWordChar(char c) {
+  return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') ||
+         (c >= 'a' && c <= 'z') || c == '_';
+}
+
+// Case-insensitive version of /(?:^|\W)token(?:$|\W)/.
+bool HasHeaderToken(const char* value, size_t length, const char* token) {
+  const size_t token_length = strlen(token);
+  for (size_t i = 0; i + token_length <= length; i++) {
+    if ((i == 0 || !IsWordChar(value[i - 1])) &&
+        (i + token_length == length || !IsWordChar(value[i + token_length])) &&
+        StringEqualNoCaseN(value + i, token, token_length)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Records what the header `name: value` means for the outgoing message, like
+// matchHeader() in lib/_http_outgoing.js did.
+void MatchOutgoingHeader(AliasedUint8Array* state,
+                         const char* name,
+                         size_t name_length,
+                         const char* value,
+                         size_t value_length) {
+  if (name_length < 4 || name_length > 17)
+    return;
+  auto is = [&](const char* field) {
+    return strlen(field) == name_length &&
+           StringEqualNoCaseN(name, field, name_length);
+  };
+  if (is("connection")) {
+    (*state)[kHasConnection] = 1;
+    if (HasHeaderToken(value, value_length, "close"))
+      (*state)[kConnectionClose] = 1;
+    else
+      (*state)[kConnectionKeepAlive] = 1;
+  } else if (is("transfer-encoding")) {
+    (*state)[kHasTransferEncoding] = 1;
+    if (HasHeaderToken(value, value_length, "chunked"))
+      (*state)[kChunked] = 1;
+  } else if (is("content-length")) {
+    (*state)[kHasContentLength] = 1;
+  } else if (is("date")) {
+    (*state)[kHasDate] = 1;
+  } else if (is("expect")) {
+    (*state)[kHasExpect] = 1;
+  } else if (is("trailer")) {
+    (*state)[kHasTrailer] = 1;
+  } else if (is("keep-alive")) {
+    (*state)[kHasKeepAlive] = 1;
+  }
+}
+
+// serializeHeaders(headers, validate, sendDate) turns a flat array of header
+// names and values into the header lines of an outgoing message, adding a
+// Date header if `sendDate` is set and there is none. If `validate` is set
+// and a name or value is invalid, returns the index of that pair instead so
+// that JS can throw the matching error.
+void SerializeHeaders(const FunctionCallbackInfo<Value>& args) {
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  Environment* env = binding_data->env();
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsArray());
+  Local<Array> headers = args[0].As<Array>();
+  const bool validate = args[1]->IsTrue();
+  const bool send_date = args[2]->IsTrue();
+
+  AliasedUint8Array* state = &binding_data->outgoing_header_state;
+  for (size_t i = 0; i < kOutgoingHeaderStateFieldsCount; i++)
+    (*state)[i] = 0;
+
+  std::string head;
+  head.reserve(512);
+  const uint32_t length = headers->Length();
+  for (uint32_t i = 0; i + 1 < length; i += 2) {
+    Local<Value> name_value;
+    Local<Value> value_value;
+    if (!headers->Get(context, i).ToLocal(&name_value) ||
+        !headers->Get(context, i + 1).ToLocal(&value_value)) {
+      return;
+    }
+    if (validate && (!name_value->IsString() ||
+                     name_value.As<String>()->Length() == 0)) {
+      return args.GetReturnValue().Set(i);
+    }
+
+    Local<String> name;
+    if (!name_value->ToString(context).ToLocal(&name))
+      return;
+    const size_t name_offset = head.size();
+    if (!AppendHeaderString(isolate, &head, name,
+                            validate ? kHeaderChars.token : nullptr) ||
+        (validate && value_value->IsUndefined())) {
+      return args.GetReturnValue().Set(i);
+    }
+    head += ": ";
+
+    Local<String> value;
+    if (!value_value->ToString(context).ToLocal(&value))
+      return;
+    const size_t value_offset = head.size();
+    if (!AppendHeaderString(isolate, &head, value,
+                            validate ? kHeaderChars.value : nullptr)) {
+      return args.GetReturnValue().Set(i);
+    }
+    const size_t value_length = head.size() - value_offset;
+    head += "\r\n";
+
+    MatchOutgoingHeader(state,
+                        head.data() + name_offset,
+                        name->Length(),
+                        head.data() + value_offset,
+                        value_length);
+  }
+
+  if (send_date && !(*state)[kHasDate]) {
+    head += "Date: ";
+    head.append(binding_data->UTCDate(), kUTCDateLength);
+    head += "\r\n";
+  }
+
+  Local<String> ret;
+  if (String::NewFromOneByte(isolate,
+                             reinterpret_cast<const uint8_t*>(head.data()),
+                             NewStringType::kNormal,
+                             head.size()).ToLocal(&ret)) {
+    args.GetReturnValue().Set(ret);
+  }
+}
+
+void GetUTCDate(const FunctionCallbackInfo<Value>& args) {
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  args.GetReturnValue().Set(binding_data->UTCDateString());
+}
+
 // helper class for the Parser
 struct StringPtr {
   StringPtr() {
@@ -170,10 +815,15 @@ struct StringPtr {
 
 
   // Strip trailing OWS (SPC or HTAB) from string.
-  Local<String> ToTrimmedString(Environment* env) {
+  void Trim() {
     while (size_ > 0 && IsOWS(str_[size_ - 1])) {
       size_--;
     }
+  }
+
+
+  Local<String> ToTrimmedString(Environment* env) {
+    Trim();
     return ToString(env);
   }
 
@@ -183,12 +833,156 @@ struct StringPtr {
   size_t size_;
 };
 
+// The header lines of a message, copied into a single ArrayBuffer so that JS
+// strings are only created for the ones that are actually read. The buffer
+// starts with the number of lines, followed by the offset and length of the
+// name and the value of each line, followed by the bytes of the lines.
+// The buffer is reachable from JS, so user code may have modified, detached
+// or replaced it. IsValid() needs to be checked before anything else is read.
+class HeaderBlock {
+ public:
+  explicit HeaderBlock(Local<ArrayBuffer> buffer)
+      : store_(buffer->GetBackingStore()) {}
+
+  static Local<ArrayBuffer> New(Isolate* isolate,
+                                const StringPtr* names,
+                                const StringPtr* values,
+                                size_t count) {
+    size_t offset = sizeof(uint32_t) * (1 + count * 4);
+    size_t size = offset;
+    for (size_t i = 0; i < count; i++)
+      size += names[i].size_ + values[i].size_;
+
+    Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, size);
+    uint32_t* table = static_cast<uint32_t*>(buffer->GetBackingStore()->Data());
+    char* data = reinterpret_cast<char*>(table);
+    table[0] = count;
+    for (size_t i = 0; i < count; i++) {
+      const StringPtr* strings[] = { &names[i], &values[i] };
+      for (size_t j = 0; j < arraysize(strings); j++) {
+        table[1 + i * 4 + j * 2] = offset;
+        table[2 + i * 4 + j * 2] = strings[j]->size_;
+        if (strings[j]->size_ > 0)
+          memcpy(data + offset, strings[j]->str_, strings[j]->size_);
+        offset += strings[j]->size_;
+      }
+    }
+    return buffer;
+  }
+
+  // Checks that the table and every name and value are within the buffer.
+  bool IsValid() {
+    // A detached buffer has a length of 0.
+    const size_t byte_length = store_->ByteLength();
+    if (byte_length < sizeof(uint32_t))
+      return false;
+    const uint32_t* table = static_cast<const uint32_t*>(store_->Data());
+    const size_t count = table[0];
+    if (count > kMaxHeaderFieldsCount ||
+        byte_length < sizeof(uint32_t) * (1 + count * 4)) {
+      return false;
+    }
+    for (size_t i = 0; i < count * 2; i++) {
+      const size_t offset = table[1 + i * 2];
+      const size_t length = table[2 + i * 2];
+      if (offset > byte_length || length > byte_length - offset)
+        return false;
+    }
+    table_ = table;
+    return true;
+  }
+
+  size_t size() const { return table_[0]; }
+  const char* name(size_t i) const { return data() + table_[1 + i * 4]; }
+  size_t name_length(size_t i) const { return table_[2 + i * 4]; }
+  const char* value(size_t i) const { return data() + table_[3 + i * 4]; }
+  size_t value_length(size_t i) const { return table_[4 + i * 4]; }
+
+ private:
+  const char* data() const { return reinterpret_cast<const char*>(table_); }
+
+  std::shared_ptr<BackingStore> store_;
+  const uint32_t* table_ = nullptr;
+};
+
+// Returns the number of lines of a header block that are turned into
+// headers, given the `maxHeaderPairs` limit of the message in `max_entries`.
+size_t HeaderBlockLimit(const HeaderBlock& block, Local<Value> max_entries) {
+  const size_t size = block.size();
+  if (!max_entries->IsUint32())
+    return size;
+  const uint32_t max = max_entries.As<Uint32>()->Value();
+  if (max == 0)
+    return size;
+  return std::min<size_t>(size, (static_cast<size_t>(max) + 1) / 2);
+}
+
+// getHeaderBlockValues(block, name, maxEntries) returns the values of all
+// lines whose name equals the lowercase `name`, ignoring case.
+void GetHeaderBlockValues(const FunctionCallbackInfo<Value>& args) {
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  Isolate* isolate = args.GetIsolate();
+  CHECK(args[1]->IsString());
+  if (!args[0]->IsArrayBuffer())
+    return THROW_ERR_INVALID_ARG_TYPE(isolate, "Invalid header block");
+  HeaderBlock block(args[0].As<ArrayBuffer>());
+  if (!block.IsValid())
+    return THROW_ERR_INVALID_ARG_VALUE(isolate, "Invalid header block");
+  Utf8Value name(isolate, args[1]);
+
+  std::vector<Local<Value>> values;
+  const size_t count = HeaderBlockLimit(block, args[2]);
+  for (size_t i = 0; i < count; i++) {
+    if (block.name_length(i) != name.length() ||
+        !StringEqualNoCaseN(block.name(i), *name, name.length())) {
+      continue;
+    }
+    Local<String> value = binding_data->LookupHeaderValue(
+        block.value(i), block.value_length(i));
+    values.push_back(value.IsEmpty() ?
+        OneByteString(isolate, block.value(i), block.value_length(i)) :
+        value);
+  }
+  args.GetReturnValue().Set(Array::New(isolate, values.data(), values.size()));
+}
+
+// materializeHeaderBlock(block) returns the lines of a header block in the
+// same form as the headers that are passed to kOnHeadersComplete, and fills
+// in header_name_ids for them.
+void MaterializeHeaderBlock(const FunctionCallbackInfo<Value>& args) {
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  Isolate* isolate = args.GetIsolate();
+  if (!args[0]->IsArrayBuffer())
+    return THROW_ERR_INVALID_ARG_TYPE(isolate, "Invalid header block");
+  HeaderBlock block(args[0].As<ArrayBuffer>());
+  if (!block.IsValid())
+    return THROW_ERR_INVALID_ARG_VALUE(isolate, "Invalid header block");
+
+  Local<Value> headers_v[kMaxHeaderFieldsCount * 2];
+  for (size_t i = 0; i < block.size(); i++) {
+    Local<String> name;
+    binding_data->header_name_ids[i] = binding_data->LookupHeaderName(
+        block.name(i), block.name_length(i), &name);
+    headers_v[i * 2] = name.IsEmpty() ?
+        OneByteString(isolate, block.name(i), block.name_length(i)) : name;
+
+    Local<String> value = binding_data->LookupHeaderValue(
+        block.value(i), block.value_length(i));
+    headers_v[i * 2 + 1] = value.IsEmpty() ?
+        OneByteString(isolate, block.value(i), block.value_length(i)) : value;
+  }
+  args.GetReturnValue().Set(
+      Array::New(isolate, headers_v, block.size() * 2));
+}
+
 class Parser : public AsyncWrap, public StreamListener {
  public:
   Parser(BindingData* binding_data, Local<Object> wrap)
       : AsyncWrap(binding_data->env(), wrap),
         current_buffer_len_(0),
         current_buffer_data_(nullptr),
+        headers_timeout_entry_(this, kOnTimeout),
+        keep_alive_timeout_entry_(this, kOnKeepAliveTimeout),
         binding_data_(binding_data) {
   }
 
@@ -205,10 +999,16 @@ class Parser : public AsyncWrap, public StreamListener {
     url_.Reset();
     status_message_.Reset();
     header_parsing_start_time_ = uv_hrtime();
+    if (headers_timeout_ != 0 && stream_ != nullptr) {
+      binding_data_->connection_timeouts.Schedule(&headers_timeout_entry_,
+                                                  headers_timeout_);
+    }
 
     Local<Value> cb = object()->Get(env()->context(), kOnMessageBegin)
                               .ToLocalChecked();
-    if (cb->IsFunction()) {
+    if (cb->IsFunction() && batching()) {
+      PushEvent(kOnMessageBegin);
+    } else if (cb->IsFunction()) {
       InternalCallbackScope callback_scope(
         this, InternalCallbackScope::kSkipTaskQueues);
 
@@ -295,6 +1095,7 @@ class Parser : public AsyncWrap, public StreamListener {
   int on_headers_complete() {
     header_nread_ = 0;
     header_parsing_start_time_ = 0;
+    ConnectionTimeoutWheel::Cancel(&headers_timeout_entry_);
 
     // Arguments for the on-headers-complete javascript callback. This
     // list needs to be kept in sync with the actual argument list for
@@ -329,7 +1130,7 @@ class Parser : public AsyncWrap, public StreamListener {
       Flush();
     } else {
       // Fast case, pass headers and URL to JS land.
-      argv[A_HEADERS] = CreateHeaders();
+      argv[A_HEADERS] = lazy_headers_ ? CreateHeaderBlock() : CreateHeaders();
       if (parser_.type == HTTP_REQUEST)
         argv[A_URL] = url_.ToString(env());
     }
@@ -362,6 +1163,19 @@ class Parser : public AsyncWrap, public StreamListener {
 
     argv[A_UPGRADE] = Boolean::New(env()->isolate(), parser_.upgrade);
 
+    if (batching()) {
+      // The return value only matters for Upgrade and CONNECT requests, which
+      // may take over the socket. Let JS catch up and decide on those.
+      if (!parser_.upgrade) {
+        PushEvent(kOnHeadersComplete, arraysize(argv), argv);
+        return 0;
+      }
+      if (batch_length_ > 0 && !DispatchEvents(batch_)) {
+        got_exception_ = true;
+        return -1;
+      }
+    }
+
     MaybeLocal<Value> head_response;
     {
       InternalCallbackScope callback_scope(
@@ -395,11 +1209,23 @@ class Parser : public AsyncWrap, public StreamListener {
 
     // We came from consumed stream
     if (current_buffer_.IsEmpty()) {
+      Local<Object> buffer;
+      const size_t remaining = current_buffer_data_ + current_buffer_len_ - at;
+      if (current_read_buffer_ != nullptr &&
+          remaining >= kZeroCopyBodyThreshold) {
+        // Hand out the read buffer itself. It stays alive for as long as JS
+        // holds on to any slice of it.
+        Local<ArrayBuffer> ab = binding_data_->read_buffer_pool->ToArrayBuffer(
+            env()->isolate(), current_read_buffer_, current_buffer_len_);
+        buffer = Buffer::New(env()->isolate(), ab, 0, current_buffer_len_)
+                     .ToLocalChecked();
+      } else {
+        buffer = Buffer::Copy(env()->isolate(),
+                              current_buffer_data_,
+                              current_buffer_len_).ToLocalChecked();
+      }
       // Make sure Buffer will be in parent HandleScope
-      current_buffer_ = scope.Escape(Buffer::Copy(
-          env()->isolate(),
-          current_buffer_data_,
-          current_buffer_len_).ToLocalChecked());
+      current_buffer_ = scope.Escape(buffer);
     }
 
     Local<Value> argv[3] = {
@@ -408,6 +1234,11 @@ class Parser : public AsyncWrap, public StreamListener {
       Integer::NewFromUnsigned(env()->isolate(), length)
     };
 
+    if (batching()) {
+      PushEvent(kOnBody, arraysize(argv), argv);
+      return 0;
+    }
+
     MaybeLocal<Value> r = MakeCallback(cb.As<Function>(),
                                        arraysize(argv),
                                        argv);
@@ -435,6 +1266,11 @@ class Parser : public AsyncWrap, public StreamListener {
     if (!cb->IsFunction())
       return 0;
 
+    if (batching()) {
+      PushEvent(kOnMessageComplete);
+      return 0;
+    }
+
     MaybeLocal<Value> r;
     {
       InternalCallbackScope callback_scope(
@@ -614,6 +1450,9 @@ class Parser : public AsyncWrap, public StreamListener {
     Parser* parser;
     ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
 
+    // Without the stream, the deadlines are tracked by JS timers again.
+    parser->CancelConnectionTimeouts();
+
     // Already unconsumed
     if (parser->stream_ == nullptr)
       return;
@@ -622,6 +1461,56 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // Arms the keep-alive timeout of a consumed connection, or disarms it if
+  // `ms` is 0. Any data that arrives on the connection disarms it, too.
+  static void SetKeepAliveTimeout(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+    CHECK(args[0]->IsNumber());
+    const int64_t ms = args[0].As<Number>()->Value();
+
+    if (ms <= 0 || parser->stream_ == nullptr) {
+      ConnectionTimeoutWheel::Cancel(&parser->keep_alive_timeout_entry_);
+      return;
+    }
+    parser->binding_data_->connection_timeouts.Schedule(
+        &parser->keep_alive_timeout_entry_, ms);
+  }
+
+
+  // In lazy headers mode, the headers of messages that fit into a single
+  // kOnHeadersComplete call are passed to JS as a HeaderBlock.
+  static void SetLazyHeaders(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+    CHECK(args[0]->IsBoolean());
+    parser->lazy_headers_ = args[0]->IsTrue();
+  }
+
+
+  // Called by the ConnectionTimeoutWheel once the deadline of `timeout` has
+  // passed.
+  void OnConnectionTimeout(ConnectionTimeout* timeout) {
+    if (timeout == &headers_timeout_entry_) {
+      // Do not report the same headers timeout again from OnStreamRead().
+      header_parsing_start_time_ = 0;
+    }
+
+    Local<Value> cb = object()->Get(env()->context(), timeout->callback)
+                          .ToLocalChecked();
+    if (!cb->IsFunction())
+      return;
+
+    MakeCallback(cb.As<Function>(), 0, nullptr);
+  }
+
+
+  void CancelConnectionTimeouts() {
+    ConnectionTimeoutWheel::Cancel(&headers_timeout_entry_);
+    ConnectionTimeoutWheel::Cancel(&keep_alive_timeout_entry_);
+  }
+
+
   static void GetCurrentBuffer(const FunctionCallbackInfo<Value>& args) {
     Parser* parser;
     ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
@@ -635,33 +1524,28 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
  protected:
-  static const size_t kAllocBufferSize = 64 * 1024;
+  // Body data that makes up at least this much of a read is passed to JS
+  // without copying, see on_body(). Smaller chunks are copied so that they do
+  // not keep a whole read buffer alive.
+  static const size_t kZeroCopyBodyThreshold = 16 * 1024;
 
   uv_buf_t OnStreamAlloc(size_t suggested_size) override {
     // For most types of streams, OnStreamRead will be immediately after
-    // OnStreamAlloc, and will consume all data, so using a static buffer for
-    // reading is more efficient. For other streams, just use Malloc() directly.
-    if (binding_data_->parser_buffer_in_use)
-      return uv_buf_init(Malloc(suggested_size), suggested_size);
-    binding_data_->parser_buffer_in_use = true;
-
-    if (binding_data_->parser_buffer.empty())
-      binding_data_->parser_buffer.resize(kAllocBufferSize);
-
-    return uv_buf_init(binding_data_->parser_buffer.data(), kAllocBufferSize);
+    // OnStreamAlloc, and will consume all data, so the buffer usually goes
+    // straight back into the pool.
+    return uv_buf_init(binding_data_->read_buffer_pool->Acquire(),
+                       ReadBufferPool::kBufferSize);
   }
 
 
   void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override {
     HandleScope scope(env()->isolate());
-    // Once we’re done here, either indicate that the HTTP parser buffer
-    // is free for re-use, or free() the data if it didn’t come from there
-    // in the first place.
+    // Once we’re done here, drop our reference to the read buffer. It is only
+    // kept alive beyond this point if on_body() has shared it with JS.
     auto on_scope_leave = OnScopeLeave([&]() {
-      if (buf.base == binding_data_->parser_buffer.data())
-        binding_data_->parser_buffer_in_use = false;
-      else
-        free(buf.base);
+      current_read_buffer_ = nullptr;
+      binding_data_->read_buffer_pool->Unref(buf.base);
+      batch_.Clear();
     });
 
     if (nread < 0) {
@@ -673,7 +1557,20 @@ class Parser : public AsyncWrap, public StreamListener {
     if (nread == 0)
       return;
 
+    ConnectionTimeoutWheel::Cancel(&keep_alive_timeout_entry_);
+
     current_buffer_.Clear();
+    current_read_buffer_ = buf.base;
+
+    // In batching mode, the parser callbacks only record their events, and
+    // all of them are passed to JS together once the read has been parsed.
+    Local<Value> events_cb =
+        object()->Get(env()->context(), kOnEvents).ToLocalChecked();
+    if (events_cb->IsFunction()) {
+      batch_ = Array::New(env()->isolate());
+      batch_length_ = 0;
+    }
+
     Local<Value> ret = Execute(buf.base, nread);
 
     // Exception
@@ -686,9 +1583,18 @@ class Parser : public AsyncWrap, public StreamListener {
       uint64_t parsing_time = (now - header_parsing_start_time_) / 1e6;
 
       if (parsing_time > headers_timeout_) {
+        ConnectionTimeoutWheel::Cancel(&headers_timeout_entry_);
         Local<Value> cb =
             object()->Get(env()->context(), kOnTimeout).ToLocalChecked();
 
+        if (batching()) {
+          PushEvent(kOnTimeout);
+          Local<Array> events = batch_;
+          batch_.Clear();
+          DispatchEvents(events);
+          return;
+        }
+
         if (!cb->IsFunction())
           return;
 
@@ -701,14 +1607,23 @@ class Parser : public AsyncWrap, public StreamListener {
     Local<Value> cb =
         object()->Get(env()->context(), kOnExecute).ToLocalChecked();
 
-    if (!cb->IsFunction())
+    // The events recorded so far need to be dispatched in any case.
+    if (!cb->IsFunction() && !batching())
       return;
 
     // Hooks for GetCurrentBuffer
     current_buffer_len_ = nread;
     current_buffer_data_ = buf.base;
 
-    MakeCallback(cb.As<Function>(), 1, &ret);
+    if (batching()) {
+      PushEvent(kOnExecute, 1, &ret);
+      // Do not record the events of any execute() calls made from JS.
+      Local<Array> events = batch_;
+      batch_.Clear();
+      DispatchEvents(events);
+    } else {
+      MakeCallback(cb.As<Function>(), 1, &ret);
+    }
 
     current_buffer_len_ = 0;
     current_buffer_data_ = nullptr;
@@ -805,15 +1720,68 @@ class Parser : public AsyncWrap, public StreamListener {
     // There could be extra entries but the max size should be fixed
     Local<Value> headers_v[kMaxHeaderFieldsCount * 2];
 
+    // Well-known names and values are served from pre-internalized strings
+    // when their spelling matches, see BindingData.
     for (size_t i = 0; i < num_values_; ++i) {
-      headers_v[i * 2] = fields_[i].ToString(env());
-      headers_v[i * 2 + 1] = values_[i].ToTrimmedString(env());
+      Local<String> name;
+      binding_data_->header_name_ids[i] = binding_data_->LookupHeaderName(
+          fields_[i].str_, fields_[i].size_, &name);
+      headers_v[i * 2] = name.IsEmpty() ? fields_[i].ToString(env()) : name;
+
+      values_[i].Trim();
+      Local<String> value = binding_data_->LookupHeaderValue(
+          values_[i].str_, values_[i].size_);
+      headers_v[i * 2 + 1] =
+          value.IsEmpty() ? values_[i].ToString(env()) : value;
     }
 
     return Array::New(env()->isolate(), headers_v, num_values_ * 2);
   }
 
 
+  Local<ArrayBuffer> CreateHeaderBlock() {
+    for (size_t i = 0; i < num_values_; ++i)
+      values_[i].Trim();
+    return HeaderBlock::New(env()->isolate(), fields_, values_, num_values_);
+  }
+
+
+  bool batching() const {
+    return !batch_.IsEmpty();
+  }
+
+
+  // Appends an event and the arguments for its callback to the batch.
+  void PushEvent(uint32_t event,
+                 size_t argc = 0,
+                 const Local<Value>* argv = nullptr) {
+    Local<Context> context = env()->context();
+    batch_->Set(context,
+                batch_length_++,
+                Integer::NewFromUnsigned(env()->isolate(), event)).Check();
+    for (size_t i = 0; i < argc; i++)
+      batch_->Set(context, batch_length_++, argv[i]).Check();
+  }
+
+
+  // Passes the events recorded so far to JS in a single callback, see
+  // `parserOnEvents` in lib/_http_common.js. Returns false if it threw.
+  bool DispatchEvents(Local<Array> events) {
+    Local<Value> argv[2] = {
+      events,
+      Integer::NewFromUnsigned(env()->isolate(), batch_length_)
+    };
+    batch_length_ = 0;
+
+    Local<Value> cb =
+        object()->Get(env()->context(), kOnEvents).ToLocalChecked();
+    if (!cb->IsFunction())
+      return true;
+
+    return !MakeCallback(cb.As<Function>(), arraysize(argv), argv).IsEmpty();
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
@@ -829,12 +1797,16 @@ class Parser : public AsyncWrap, public StreamListener {
       url_.ToString(env())
     };
 
-    MaybeLocal<Value> r = MakeCallback(cb.As<Function>(),
-                                       arraysize(argv),
-                                       argv);
+    if (batching()) {
+      PushEvent(kOnHeaders, arraysize(argv), argv);
+    } else {
+      MaybeLocal<Value> r = MakeCallback(cb.As<Function>(),
+                                         arraysize(argv),
+                                         argv);
 
-    if (r.IsEmpty())
-      got_exception_ = true;
+      if (r.IsEmpty())
+        got_exception_ = true;
+    }
 
     url_.Reset();
     have_flushed_ = true;
@@ -852,9 +1824,11 @@ class Parser : public AsyncWrap, public StreamListener {
     num_values_ = 0;
     have_flushed_ = false;
     got_exception_ = false;
+    lazy_headers_ = false;
     max_http_header_size_ = max_http_header_size;
     header_parsing_start_time_ = 0;
     headers_timeout_ = headers_timeout;
+    CancelConnectionTimeouts();
   }
 
 
@@ -898,15 +1872,26 @@ class Parser : public AsyncWrap, public StreamListener {
   size_t num_values_;
   bool have_flushed_;
   bool got_exception_;
+  bool lazy_headers_ = false;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
   const char* current_buffer_data_;
+  // Parser events of the current read that have not been passed to JS yet,
+  // if the parser is in batching mode. Reused after each DispatchEvents().
+  Local<Array> batch_;
+  uint32_t batch_length_ = 0;
+  // The pooled buffer that is being parsed, if it came from a consumed stream.
+  char* current_read_buffer_ = nullptr;
   unsigned int execute_depth_ = 0;
   bool pending_pause_ = false;
   uint64_t header_nread_ = 0;
   uint64_t max_http_header_size_;
   uint64_t headers_timeout_;
   uint64_t header_parsing_start_time_ = 0;
+  // Deadlines in the ConnectionTimeoutWheel, only used while the parser is
+  // consuming a stream.
+  ConnectionTimeout headers_timeout_entry_;
+  ConnectionTimeout keep_alive_timeout_entry_;
 
   BaseObjectPtr<BindingData> binding_data_;
 
@@ -931,6 +1916,37 @@ class Parser : public AsyncWrap, public StreamListener {
   static const llhttp_settings_t settings;
 };
 
+void ConnectionTimeoutWheel::OnTick() {
+  HandleScope handle_scope(env_->isolate());
+  Context::Scope context_scope(env_->context());
+
+  // Collect the expired deadlines first, JS may schedule or cancel others.
+  std::vector<std::pair<BaseObjectPtr<Parser>, ConnectionTimeout*>> expired;
+  const uint64_t target = uv_now(env_->event_loop()) / kTickMs;
+  while (current_tick_ < target) {
+    current_tick_++;
+    for (size_t level = kLevels - 1; level > 0; level--) {
+      if ((current_tick_ & ((1 << (kLevelBits * level)) - 1)) == 0)
+        Cascade(level);
+    }
+    Slot& slot = slots_[0][current_tick_ & kSlotMask];
+    while (ConnectionTimeout* timeout = slot.PopFront())
+      expired.emplace_back(BaseObjectPtr<Parser>(timeout->parser), timeout);
+  }
+
+  if (IsEmpty()) {
+    timer_.Stop();
+    running_ = false;
+  }
+
+  for (auto& entry : expired) {
+    // The deadline may have been armed again by an earlier callback.
+    if (!entry.second->wheel_node.IsEmpty())
+      continue;
+    entry.first->OnConnectionTimeout(entry.second);
+  }
+}
+
 const llhttp_settings_t Parser::settings = {
   Proxy<Call, &Parser::on_message_begin>::Raw,
   Proxy<DataCall, &Parser::on_url>::Raw,
@@ -975,6 +1991,10 @@ void InitializeHttpParser(Local<Object> target,
          Integer::NewFromUnsigned(env->isolate(), kOnExecute));
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnTimeout"),
          Integer::NewFromUnsigned(env->isolate(), kOnTimeout));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnEvents"),
+         Integer::NewFromUnsigned(env->isolate(), kOnEvents));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnKeepAliveTimeout"),
+         Integer::NewFromUnsigned(env->isolate(), kOnKeepAliveTimeout));
 
   Local<Array> methods = Array::New(env->isolate());
 #define V(num, name, string)                                                  \
@@ -986,6 +2006,27 @@ void InitializeHttpParser(Local<Object> target,
               FIXED_ONE_BYTE_STRING(env->isolate(), "methods"),
               methods).Check();
 
+  Local<Array> known_header_names = Array::New(env->isolate());
+  for (size_t i = 0; i < arraysize(kKnownHeaderNames); i++) {
+    known_header_names->Set(env->context(), i,
+                            OneByteString(env->isolate(),
+                                          kKnownHeaderNames[i])).Check();
+  }
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "knownHeaderNames"),
+              known_header_names).Check();
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "headerNameIds"),
+              binding_data->header_name_ids.GetJSArray()).Check();
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "outgoingHeaderState"),
+              binding_data->outgoing_header_state.GetJSArray()).Check();
+  env->SetMethod(target, "serializeHeaders", SerializeHeaders);
+  env->SetMethodNoSideEffect(target, "getUTCDate", GetUTCDate);
+  env->SetMethodNoSideEffect(target, "getHeaderBlockValues",
+                             GetHeaderBlockValues);
+  env->SetMethod(target, "materializeHeaderBlock", MaterializeHeaderBlock);
+
   t->Inherit(AsyncWrap::GetConstructorTemplate(env));
   env->SetProtoMethod(t, "close", Parser::Close);
   env->SetProtoMethod(t, "free", Parser::Free);
@@ -997,6 +2038,8 @@ void InitializeHttpParser(Local<Object> target,
   env->SetProtoMethod(t, "consume", Parser::Consume);
   env->SetProtoMethod(t, "unconsume", Parser::Unconsume);
   env->SetProtoMethod(t, "getCurrentBuffer", Parser::GetCurrentBuffer);
+  env->SetProtoMethod(t, "setKeepAliveTimeout", Parser::SetKeepAliveTimeout);
+  env->SetProtoMethod(t, "setLazyHeaders", Parser::SetLazyHeaders);
 
   env->SetConstructorFunction(target, "HTTPParser", t);
 }
@@ -28,6 +28,7 @@
 #include "node.h"
 #include "node_binding.h"
 #include "node_mutex.h"
+#include "node_perf_common.h"
 #include "tracing/trace_event.h"
 #include "util.h"
 #include "uv.h"
@@ -223,11 +224,16 @@ class InternalCallbackScope {
   Environment* env_;
   async_context async_context_;
   v8::Local<v8::Object> object_;
+  v8::Local<v8::Value> prior_async_context_frame_;
   bool skip_hooks_;
   bool skip_task_queues_;
   bool failed_ = false;
   bool pushed_ids_ = false;
+  bool entered_async_context_frame_ = false;
   bool closed_ = false;
+  // Destroyed after the destructor has run Close(), so that the time spent
+  // in the nextTick and microtask queues is included.
+  performance::AsyncCallbackTimer async_callback_timer_;
 };
 
 class DebugSealHandleScope {
@@ -246,9 +252,12 @@ class DebugSealHandleScope {
 
 class ThreadPoolWork {
  public:
+  // Work that Node.js schedules for itself, rather than on behalf of a user
+  // request, is not included in the threadpool statistics.
   explicit inline ThreadPoolWork(Environment* env) : env_(env) {
     CHECK_NOT_NULL(env);
   }
+  inline ThreadPoolWork(Environment* env, performance::ThreadPoolWorkType type);
   inline virtual ~ThreadPoolWork() = default;
 
   inline void ScheduleWork();
@@ -261,6 +270,8 @@ class ThreadPoolWork {
 
  private:
   Environment* env_;
+  performance::ThreadPoolWorkStats* stats_ = nullptr;
+  uint64_t queued_at_ = 0;
   uv_work_t work_req_;
 };
 
@@ -17,6 +17,7 @@ using v8::BackingStore;
 using v8::CompiledWasmModule;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::False;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -27,11 +28,18 @@ using v8::Just;
 using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Nothing;
+using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Symbol;
+using v8::True;
+using v8::Uint32;
+using v8::Uint8Array;
+using v8::Undefined;
 using v8::Value;
 using v8::ValueDeserializer;
 using v8::ValueSerializer;
@@ -73,7 +81,193 @@ Message::Message(MallocedBuffer<char>&& buffer)
     : main_message_buf_(std::move(buffer)) {}
 
 bool Message::IsCloseMessage() const {
-  return main_message_buf_.data == nullptr;
+  return payload().data == nullptr;
+}
+
+namespace {
+
+// Messages encoded by Message::SerializeFast() start with one of these tags
+// rather than with the version tag (0xFF) that ValueSerializer writes first.
+// Numbers and strings follow at kFastMessagePayloadOffset, so that they are
+// suitably aligned. The contents of ArrayBuffers and Uint8Arrays are passed
+// as the message's only backing store instead.
+enum FastMessageTag : uint8_t {
+  kFastUndefined = 1,
+  kFastNull,
+  kFastTrue,
+  kFastFalse,
+  kFastNumber,
+  kFastOneByteString,
+  kFastTwoByteString,
+  kFastArrayBuffer,
+  kFastUint8Array
+};
+
+constexpr size_t kFastMessagePayloadOffset = sizeof(double);
+
+}  // anonymous namespace
+
+bool Message::IsFastMessage() const {
+  uint8_t tag = payload().data[0];
+  return tag >= kFastUndefined && tag <= kFastUint8Array;
+}
+
+bool Message::SerializeFast(Environment* env,
+                            Local<Context> context,
+                            Local<Value> input,
+                            const TransferList& transfer_list_v) {
+  Isolate* isolate = env->isolate();
+
+  if (input->IsArrayBuffer() || input->IsUint8Array()) {
+    Local<ArrayBuffer> ab;
+    if (input->IsArrayBuffer()) {
+      ab = input.As<ArrayBuffer>();
+    } else {
+      // Views of only a part of their buffer keep the whole buffer and their
+      // offset when they are serialized, so let the general path do that.
+      // The same goes for views of SharedArrayBuffers, whose memory is shared
+      // with the receiver rather than copied.
+      Local<Uint8Array> view = input.As<Uint8Array>();
+      ab = view->Buffer();
+      if (ab.As<Value>()->IsSharedArrayBuffer() ||
+          view->ByteOffset() != 0 ||
+          view->ByteLength() != ab->ByteLength()) {
+        return false;
+      }
+    }
+    // This also leaves detached ArrayBuffers to the general path, which
+    // reports them as errors.
+    size_t length = ab->ByteLength();
+    if (length == 0)
+      return false;
+
+    std::shared_ptr<BackingStore> backing_store;
+    if (transfer_list_v.length() == 0) {
+      backing_store = ArrayBuffer::NewBackingStore(isolate, length);
+      memcpy(backing_store->Data(), ab->GetBackingStore()->Data(), length);
+    } else {
+      if (transfer_list_v.length() != 1 || transfer_list_v[0] != ab)
+        return false;
+      bool untransferable;
+      if (!ab->HasPrivate(context, env->untransferable_object_private_symbol())
+              .To(&untransferable) ||
+          untransferable ||
+          !ab->IsDetachable()) {
+        return false;
+      }
+      backing_store = ab->GetBackingStore();
+      ab->Detach();
+    }
+
+    main_message_buf_ = MallocedBuffer<char>(1);
+    main_message_buf_.data[0] =
+        input->IsArrayBuffer() ? kFastArrayBuffer : kFastUint8Array;
+    array_buffers_.emplace_back(std::move(backing_store));
+    return true;
+  }
+
+  // Anything in the transfer list would have to be transferred even though
+  // it is not part of the message.
+  if (transfer_list_v.length() != 0)
+    return false;
+
+  uint8_t tag;
+  size_t length = 0;
+  if (input->IsUndefined()) {
+    tag = kFastUndefined;
+  } else if (input->IsNull()) {
+    tag = kFastNull;
+  } else if (input->IsTrue()) {
+    tag = kFastTrue;
+  } else if (input->IsFalse()) {
+    tag = kFastFalse;
+  } else if (input->IsNumber()) {
+    tag = kFastNumber;
+    length = sizeof(double);
+  } else if (input->IsString()) {
+    Local<String> string = input.As<String>();
+    if (string->IsOneByte()) {
+      tag = kFastOneByteString;
+      length = string->Length();
+    } else {
+      tag = kFastTwoByteString;
+      length = string->Length() * sizeof(uint16_t);
+    }
+  } else {
+    return false;
+  }
+
+  main_message_buf_ = MallocedBuffer<char>(
+      length == 0 ? 1 : kFastMessagePayloadOffset + length);
+  main_message_buf_.data[0] = tag;
+  if (length == 0)
+    return true;
+
+  char* payload = main_message_buf_.data + kFastMessagePayloadOffset;
+  if (tag == kFastNumber) {
+    double value = input.As<Number>()->Value();
+    memcpy(payload, &value, sizeof(value));
+  } else if (tag == kFastOneByteString) {
+    input.As<String>()->WriteOneByte(isolate,
+                                     reinterpret_cast<uint8_t*>(payload),
+                                     0,
+                                     -1,
+                                     String::NO_NULL_TERMINATION);
+  } else if (tag == kFastTwoByteString) {
+    input.As<String>()->Write(isolate,
+                              reinterpret_cast<uint16_t*>(payload),
+                              0,
+                              -1,
+                              String::NO_NULL_TERMINATION);
+  }
+  return true;
+}
+
+MaybeLocal<Value> Message::DeserializeFast(Environment* env) {
+  Isolate* isolate = env->isolate();
+  const MallocedBuffer<char>& buf = this->payload();
+  uint8_t tag = buf.data[0];
+  const char* payload = buf.data + kFastMessagePayloadOffset;
+  size_t length = buf.size > kFastMessagePayloadOffset ?
+      buf.size - kFastMessagePayloadOffset : 0;
+
+  switch (tag) {
+    case kFastUndefined:
+      return Undefined(isolate);
+    case kFastNull:
+      return Null(isolate);
+    case kFastTrue:
+      return True(isolate);
+    case kFastFalse:
+      return False(isolate);
+    case kFastNumber: {
+      double value;
+      memcpy(&value, payload, sizeof(value));
+      return Number::New(isolate, value);
+    }
+    case kFastOneByteString:
+      return String::NewFromOneByte(isolate,
+                                    reinterpret_cast<const uint8_t*>(payload),
+                                    NewStringType::kNormal,
+                                    static_cast<int>(length));
+    case kFastTwoByteString:
+      return String::NewFromTwoByte(isolate,
+                                    reinterpret_cast<const uint16_t*>(payload),
+                                    NewStringType::kNormal,
+                                    static_cast<int>(length / 2));
+    case kFastArrayBuffer:
+    case kFastUint8Array: {
+      CHECK_EQ(array_buffers_.size(), 1);
+      size_t byte_length = array_buffers_[0]->ByteLength();
+      Local<ArrayBuffer> ab =
+          ArrayBuffer::New(isolate, std::move(array_buffers_[0]));
+      array_buffers_.clear();
+      if (tag == kFastArrayBuffer)
+        return ab;
+      return Uint8Array::New(ab, 0, byte_length);
+    }
+  }
+  UNREACHABLE();
 }
 
 namespace {
@@ -131,6 +325,13 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   EscapableHandleScope handle_scope(env->isolate());
   Context::Scope context_scope(context);
 
+  if (IsFastMessage()) {
+    Local<Value> value;
+    if (!DeserializeFast(env).ToLocal(&value))
+      return {};
+    return handle_scope.Escape(value);
+  }
+
   // Create all necessary objects for transferables, e.g. MessagePort handles.
   std::vector<BaseObjectPtr<BaseObject>> host_objects(transferables_.size());
   auto cleanup = OnScopeLeave([&]() {
@@ -166,8 +367,8 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
       this, env, host_objects, shared_array_buffers, wasm_modules_);
   ValueDeserializer deserializer(
       env->isolate(),
-      reinterpret_cast<const uint8_t*>(main_message_buf_.data),
-      main_message_buf_.size,
+      reinterpret_cast<const uint8_t*>(payload().data),
+      payload().size,
       &delegate);
   delegate.deserializer = &deserializer;
 
@@ -208,6 +409,34 @@ uint32_t Message::AddWASMModule(CompiledWasmModule&& mod) {
   return wasm_modules_.size() - 1;
 }
 
+bool Message::IsShareable() const {
+  if (IsCloseMessage() || !transferables_.empty())
+    return false;
+  // Transferred ArrayBuffers can only be attached to one receiver. The only
+  // other ArrayBuffers in here are the copies made by SerializeFast().
+  return array_buffers_.empty() || IsFastMessage();
+}
+
+Message Message::Share(Environment* env) {
+  CHECK(IsShareable());
+  if (!shared_message_buf_) {
+    shared_message_buf_ =
+        std::make_shared<MallocedBuffer<char>>(std::move(main_message_buf_));
+  }
+
+  Message message;
+  message.shared_message_buf_ = shared_message_buf_;
+  message.shared_array_buffers_ = shared_array_buffers_;
+  message.wasm_modules_ = wasm_modules_;
+  for (const std::shared_ptr<BackingStore>& source : array_buffers_) {
+    std::shared_ptr<BackingStore> copy =
+        ArrayBuffer::NewBackingStore(env->isolate(), source->ByteLength());
+    memcpy(copy->Data(), source->Data(), source->ByteLength());
+    message.array_buffers_.emplace_back(std::move(copy));
+  }
+  return message;
+}
+
 namespace {
 
 MaybeLocal<Function> GetEmitMessageFunction(Local<Context> context) {
@@ -394,6 +623,9 @@ Maybe<bool> Message::Serialize(Environment* env,
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
 
+  if (SerializeFast(env, context, input, transfer_list_v))
+    return Just(true);
+
   SerializerDelegate delegate(env, context, this);
   ValueSerializer serializer(env->isolate(), &delegate);
   delegate.serializer = &serializer;
@@ -769,10 +1001,14 @@ void MessagePort::OnMessage() {
       continue;
     }
 
-    argv[0] = payload;
+    argv[0] = batch_size_ == 0 ? payload :
+        ReceiveBatch(context, payload, &processing_limit, &message_error);
     argv[1] = env()->message_string();
 
-    if (MakeCallback(emit_message, arraysize(argv), argv).IsEmpty()) {
+    // If a message could not be received after the ones in the batch, report
+    // the error only after the batch has been emitted, to keep the order.
+    if (MakeCallback(emit_message, arraysize(argv), argv).IsEmpty() ||
+        !message_error.IsEmpty()) {
     reschedule:
       if (!message_error.IsEmpty()) {
         argv[0] = message_error;
@@ -788,6 +1024,30 @@ void MessagePort::OnMessage() {
   }
 }
 
+// Receives up to batch_size_ messages, including `first`, and returns them as
+// an array. Every message after the first one counts towards the processing
+// limit of the OnMessage() call. If a message cannot be received, the batch
+// ends there and the error, if any, is stored in `message_error`.
+Local<Value> MessagePort::ReceiveBatch(Local<Context> context,
+                                       Local<Value> first,
+                                       size_t* processing_limit,
+                                       Local<Value>* message_error) {
+  std::vector<Local<Value>> messages { first };
+  while (data_ && messages.size() < batch_size_ && *processing_limit > 0) {
+    Local<Value> payload;
+    TryCatchScope try_catch(env());
+    if (!ReceiveMessage(context, true).ToLocal(&payload)) {
+      if (try_catch.HasCaught() && !try_catch.HasTerminated())
+        *message_error = try_catch.Exception();
+      break;
+    }
+    if (payload == env()->no_message_symbol()) break;
+    --*processing_limit;
+    messages.push_back(payload);
+  }
+  return Array::New(env()->isolate(), messages.data(), messages.size());
+}
+
 void MessagePort::OnClose() {
   Debug(this, "MessagePort::OnClose()");
   if (data_) {
@@ -1034,6 +1294,69 @@ void MessagePort::ReceiveMessage(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(payload.ToLocalChecked());
 }
 
+void MessagePort::SetBatchSize(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (!args[0]->IsObject() ||
+      !env->message_port_constructor_template()->HasInstance(args[0])) {
+    return THROW_ERR_INVALID_ARG_TYPE(env,
+        "The \"port\" argument must be a MessagePort instance");
+  }
+  CHECK(args[1]->IsUint32());
+  MessagePort* port = Unwrap<MessagePort>(args[0].As<Object>());
+  if (port == nullptr) return;
+  port->batch_size_ = args[1].As<Uint32>()->Value();
+}
+
+// Post the same message to all MessagePorts in args[0]. Unless the message
+// contains cloned host objects, it is serialized only once, and all receivers
+// deserialize it from the same payload.
+void MessagePort::Broadcast(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+  CHECK(args[0]->IsArray());
+  Local<Array> targets = args[0].As<Array>();
+  const uint32_t count = targets->Length();
+
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> target;
+    if (!targets->Get(context, i).ToLocal(&target)) return;
+    if (!target->IsObject() ||
+        !env->message_port_constructor_template()->HasInstance(target)) {
+      return THROW_ERR_INVALID_ARG_TYPE(env,
+          "The \"targets\" argument must be an array of MessagePort or "
+          "Worker instances");
+    }
+  }
+
+  Message message;
+  if (message.Serialize(env, context, args[1], TransferList()).IsNothing())
+    return;
+  const bool shareable = message.IsShareable();
+
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> target;
+    if (!targets->Get(context, i).ToLocal(&target)) return;
+
+    // Serializing again may run user code, so the port is only looked at
+    // right before delivering to it.
+    Message copy;
+    if (shareable) {
+      copy = i + 1 == count ? std::move(message) : message.Share(env);
+    } else if (i == 0) {
+      copy = std::move(message);
+    } else if (copy.Serialize(env, context, args[1], TransferList())
+                   .IsNothing()) {
+      return;
+    }
+
+    MessagePort* port = Unwrap<MessagePort>(target.As<Object>());
+    if (port == nullptr || port->IsDetached()) continue;
+    Mutex::ScopedLock lock(*port->data_->sibling_mutex_);
+    if (port->data_->sibling_ != nullptr)
+      port->data_->sibling_->AddToIncomingQueue(std::move(copy));
+  }
+}
+
 void MessagePort::MoveToContext(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   if (!args[0]->IsObject() ||
@@ -1340,6 +1663,8 @@ static void InitMessaging(Local<Object> target,
   env->SetMethod(target, "stopMessagePort", MessagePort::Stop);
   env->SetMethod(target, "drainMessagePort", MessagePort::Drain);
   env->SetMethod(target, "receiveMessageOnPort", MessagePort::ReceiveMessage);
+  env->SetMethod(target, "setMessagePortBatchSize", MessagePort::SetBatchSize);
+  env->SetMethod(target, "broadcastMessage", MessagePort::Broadcast);
   env->SetMethod(target, "moveMessagePortToContext",
                  MessagePort::MoveToContext);
   env->SetMethod(target, "setDeserializerCreateObjectFunction",
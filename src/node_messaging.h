@@ -90,13 +90,38 @@ class Message : public MemoryRetainer {
     return transferables_;
   }
 
+  // Whether Share() can be used, i.e. whether this message contains nothing
+  // that can only be received once, like transferred or cloned host objects.
+  bool IsShareable() const;
+  // Create a message that refers to the same serialized payload as this one,
+  // so that it can be delivered to several ports while only being serialized
+  // once. Only ArrayBuffers sent through the fast path are copied, since
+  // each receiver gets its own.
+  Message Share(Environment* env);
+
   void MemoryInfo(MemoryTracker* tracker) const override;
 
   SET_MEMORY_INFO_NAME(Message)
   SET_SELF_SIZE(Message)
 
  private:
+  // Primitive values, strings and single ArrayBuffers or Uint8Arrays are
+  // encoded without going through v8::ValueSerializer. SerializeFast()
+  // returns false if `input` needs to take the general path.
+  bool SerializeFast(Environment* env,
+                     v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> input,
+                     const TransferList& transfer_list);
+  bool IsFastMessage() const;
+  v8::MaybeLocal<v8::Value> DeserializeFast(Environment* env);
+  // The serialized payload, which is main_message_buf_ unless the message
+  // has been shared.
+  const MallocedBuffer<char>& payload() const {
+    return shared_message_buf_ ? *shared_message_buf_ : main_message_buf_;
+  }
+
   MallocedBuffer<char> main_message_buf_;
+  std::shared_ptr<const MallocedBuffer<char>> shared_message_buf_;
   std::vector<std::shared_ptr<v8::BackingStore>> array_buffers_;
   std::vector<std::shared_ptr<v8::BackingStore>> shared_array_buffers_;
   std::vector<std::unique_ptr<TransferData>> transferables_;
@@ -198,6 +223,8 @@ class MessagePort : public HandleWrap {
   static void Stop(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Drain(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void ReceiveMessage(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetBatchSize(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Broadcast(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   /* static */
   static void MoveToContext(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -237,9 +264,16 @@ class MessagePort : public HandleWrap {
   void TriggerAsync();
   v8::MaybeLocal<v8::Value> ReceiveMessage(v8::Local<v8::Context> context,
                                            bool only_if_receiving);
+  v8::Local<v8::Value> ReceiveBatch(v8::Local<v8::Context> context,
+                                    v8::Local<v8::Value> first,
+                                    size_t* processing_limit,
+                                    v8::Local<v8::Value>* message_error);
 
   std::unique_ptr<MessagePortData> data_ = nullptr;
   bool receiving_messages_ = false;
+  // If not 0, OnMessage() emits arrays of up to this many messages rather
+  // than emitting each message on its own.
+  uint32_t batch_size_ = 0;
   uv_async_t async_;
   v8::Global<v8::Function> emit_message_fn_;
 
@@ -8,10 +8,12 @@
 #include "util-inl.h"
 
 #include <cinttypes>
+#include <utility>
 
 namespace node {
 namespace performance {
 
+using v8::Array;
 using v8::Context;
 using v8::DontDelete;
 using v8::Function;
@@ -50,6 +52,16 @@ void PerformanceState::Mark(enum PerformanceMilestone milestone,
       TRACE_EVENT_SCOPE_THREAD, ts / 1000);
 }
 
+// Two significant figures keep the histograms small, since they are
+// allocated per Environment and work type, and are always recorded into.
+void ThreadPoolWorkStats::CreateHistograms() {
+  constexpr int kFigures = 2;
+  wait_time = std::make_shared<Histogram>(
+      1, std::numeric_limits<int64_t>::max(), kFigures);
+  run_time = std::make_shared<Histogram>(
+      1, std::numeric_limits<int64_t>::max(), kFigures);
+}
+
 // Initialize the performance entry object properties
 inline void InitObject(const PerformanceEntry& entry, Local<Object> obj) {
   Environment* env = entry.env();
@@ -402,6 +414,88 @@ void LoopIdleTime(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(1.0 * idle_time / 1e6);
 }
 
+// Turn accounting of callbacks into JS by async resource type on or off.
+void SetAsyncCallbackTracking(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsBoolean());
+  env->performance_state()->track_async_callbacks = args[0]->IsTrue();
+}
+
+// Returns a copy of the current state of `histogram`, with the times in
+// nanoseconds. Unlike a HistogramBase, the copy cannot reset the histogram,
+// which keeps being recorded into for the lifetime of the Environment.
+static MaybeLocal<Object> GetHistogramSnapshot(Environment* env,
+                                               Histogram* histogram) {
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  const int64_t count = histogram->Count();
+  // Work may have been queued without any of it having started yet.
+  const bool empty = count == 0;
+  const std::pair<const char*, double> fields[] = {
+    { "count", static_cast<double>(count) },
+    { "min", empty ? 0 : static_cast<double>(histogram->Min()) },
+    { "max", empty ? 0 : static_cast<double>(histogram->Max()) },
+    { "mean", empty ? 0 : histogram->Mean() },
+    { "stddev", empty ? 0 : histogram->Stddev() },
+    { "p50", empty ? 0 : histogram->Percentile(50) },
+    { "p99", empty ? 0 : histogram->Percentile(99) },
+  };
+  Local<Object> snapshot = Object::New(isolate);
+  for (const auto& field : fields) {
+    if (snapshot->Set(context,
+                      OneByteString(isolate, field.first),
+                      Number::New(isolate, field.second)).IsNothing()) {
+      return MaybeLocal<Object>();
+    }
+  }
+  return snapshot;
+}
+
+// Returns an object with the current counts and copies of the histograms for
+// each type of work that this thread has submitted to the threadpool so far.
+void GetThreadPoolWorkStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  Local<Object> result = Object::New(isolate);
+  for (size_t i = 0; i < NODE_PERFORMANCE_THREADPOOL_WORK_INVALID; i++) {
+    ThreadPoolWorkStats& stats =
+        env->performance_state()->threadpool_work_stats[i];
+    // Work of this type was never scheduled.
+    if (!stats.wait_time) continue;
+
+    Local<Object> wait_time;
+    Local<Object> run_time;
+    if (!GetHistogramSnapshot(env, stats.wait_time.get()).ToLocal(&wait_time) ||
+        !GetHistogramSnapshot(env, stats.run_time.get()).ToLocal(&run_time)) {
+      return;
+    }
+
+    Local<Object> entry = Object::New(isolate);
+    if (entry->Set(context,
+                   FIXED_ONE_BYTE_STRING(isolate, "queued"),
+                   Integer::NewFromUnsigned(isolate, stats.queued))
+            .IsNothing() ||
+        entry->Set(context,
+                   FIXED_ONE_BYTE_STRING(isolate, "running"),
+                   Integer::NewFromUnsigned(isolate, stats.running))
+            .IsNothing() ||
+        entry->Set(context,
+                   FIXED_ONE_BYTE_STRING(isolate, "waitTime"),
+                   wait_time).IsNothing() ||
+        entry->Set(context,
+                   FIXED_ONE_BYTE_STRING(isolate, "runTime"),
+                   run_time).IsNothing() ||
+        result->Set(context,
+                    OneByteString(isolate, GetThreadPoolWorkTypeName(
+                        static_cast<ThreadPoolWorkType>(i))),
+                    entry).IsNothing()) {
+      return;
+    }
+  }
+  args.GetReturnValue().Set(result);
+}
+
 // Event Loop Timing Histogram
 void ELDHistogram::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -457,6 +551,22 @@ void Initialize(Local<Object> target,
   target->Set(context,
               FIXED_ONE_BYTE_STRING(isolate, "milestones"),
               state->milestones.GetJSArray()).Check();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "asyncCallbackStats"),
+              state->async_callback_stats.GetJSArray()).Check();
+
+  // The names of the types that async_callback_stats is indexed by.
+  Local<Array> async_callback_types =
+      Array::New(isolate, NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID);
+  for (uint32_t i = 0; i < NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID; i++) {
+    async_callback_types->Set(
+        context,
+        i,
+        OneByteString(isolate, GetAsyncCallbackTypeName(i))).Check();
+  }
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "asyncCallbackTypes"),
+              async_callback_types).Check();
 
   Local<String> performanceEntryString =
       FIXED_ONE_BYTE_STRING(isolate, "PerformanceEntry");
@@ -481,6 +591,8 @@ void Initialize(Local<Object> target,
                  RemoveGarbageCollectionTracking);
   env->SetMethod(target, "notify", Notify);
   env->SetMethod(target, "loopIdleTime", LoopIdleTime);
+  env->SetMethod(target, "setAsyncCallbackTracking", SetAsyncCallbackTracking);
+  env->SetMethod(target, "getThreadPoolWorkStats", GetThreadPoolWorkStats);
 
   Local<Object> constants = Object::New(isolate);
 
@@ -514,6 +626,12 @@ void Initialize(Local<Object> target,
   NODE_PERFORMANCE_MILESTONES(V)
 #undef V
 
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_ASYNC_CALLBACK_COUNT);
+  NODE_DEFINE_HIDDEN_CONSTANT(constants,
+                              NODE_PERFORMANCE_ASYNC_CALLBACK_DURATION);
+  NODE_DEFINE_HIDDEN_CONSTANT(constants,
+                              NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS);
+
   PropertyAttribute attr =
       static_cast<PropertyAttribute>(ReadOnly | DontDelete);
 
@@ -40,6 +40,30 @@ static inline PerformanceMilestone ToPerformanceMilestoneEnum(const char* str) {
   return NODE_PERFORMANCE_MILESTONE_INVALID;
 }
 
+static inline const char* GetThreadPoolWorkTypeName(ThreadPoolWorkType type) {
+  switch (type) {
+#define V(name, label)                                                        \
+    case NODE_PERFORMANCE_THREADPOOL_WORK_##name: return label;
+  NODE_PERFORMANCE_THREADPOOL_WORK_TYPES(V)
+#undef V
+    default:
+      UNREACHABLE();
+  }
+}
+
+static inline const char* GetAsyncCallbackTypeName(size_t type) {
+  switch (type) {
+#define V(PROVIDER)                                                           \
+    case AsyncWrap::PROVIDER_##PROVIDER: return #PROVIDER;
+  NODE_ASYNC_PROVIDER_TYPES(V)
+#undef V
+    case NODE_PERFORMANCE_ASYNC_CALLBACK_TIMEOUT: return "Timeout";
+    case NODE_PERFORMANCE_ASYNC_CALLBACK_IMMEDIATE: return "Immediate";
+    default:
+      UNREACHABLE();
+  }
+}
+
 static inline PerformanceEntryType ToPerformanceEntryTypeEnum(
     const char* type) {
 #define V(name, label)                                                        \
@@ -4,15 +4,21 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "aliased_buffer.h"
+#include "async_wrap.h"
 #include "node.h"
 #include "uv.h"
 #include "v8.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace node {
+
+class Histogram;
+
 namespace performance {
 
 #define PERFORMANCE_NOW() uv_hrtime()
@@ -39,6 +45,12 @@ extern uint64_t performance_v8_start;
   V(HTTP2, "http2")                                                           \
   V(HTTP, "http")
 
+#define NODE_PERFORMANCE_THREADPOOL_WORK_TYPES(V)                             \
+  V(CRYPTO, "crypto")                                                         \
+  V(ZLIB, "zlib")                                                             \
+  V(NAPI, "napi")                                                             \
+  V(BLOB, "blob")
+
 enum PerformanceMilestone {
 #define V(name, _) NODE_PERFORMANCE_MILESTONE_##name,
   NODE_PERFORMANCE_MILESTONES(V)
@@ -53,6 +65,51 @@ enum PerformanceEntryType {
   NODE_PERFORMANCE_ENTRY_TYPE_INVALID
 };
 
+enum ThreadPoolWorkType {
+#define V(name, _) NODE_PERFORMANCE_THREADPOOL_WORK_##name,
+  NODE_PERFORMANCE_THREADPOOL_WORK_TYPES(V)
+#undef V
+  NODE_PERFORMANCE_THREADPOOL_WORK_INVALID
+};
+
+// Statistics for one type of ThreadPoolWork. The histograms and counters are
+// updated from the threadpool threads as well as from the event loop thread.
+struct ThreadPoolWorkStats {
+  // The histograms are only allocated once they are needed, because most
+  // threads never run work of most types. This happens on the event loop
+  // thread, before any work of this type is submitted.
+  inline void EnsureHistograms() {
+    if (!wait_time) CreateHistograms();
+  }
+  void CreateHistograms();
+
+  // Time from submitting the work until a thread starts running it, in
+  // nanoseconds.
+  std::shared_ptr<Histogram> wait_time;
+  // Time that a thread spends running the work, in nanoseconds.
+  std::shared_ptr<Histogram> run_time;
+  // Work that has been submitted but not picked up by a thread yet.
+  std::atomic<uint32_t> queued {0};
+  // Work that a thread is currently running.
+  std::atomic<uint32_t> running {0};
+};
+
+// Callbacks from the event loop into JS are accounted to the provider type of
+// the AsyncWrap that makes them, or to one of these for the timer and
+// immediate queues, which are run on behalf of the process object.
+enum AsyncCallbackType {
+  NODE_PERFORMANCE_ASYNC_CALLBACK_TIMEOUT = AsyncWrap::PROVIDERS_LENGTH,
+  NODE_PERFORMANCE_ASYNC_CALLBACK_IMMEDIATE,
+  NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID
+};
+
+// For each AsyncCallbackType, async_callback_stats holds these fields.
+enum AsyncCallbackStatsFields {
+  NODE_PERFORMANCE_ASYNC_CALLBACK_COUNT,
+  NODE_PERFORMANCE_ASYNC_CALLBACK_DURATION,
+  NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS
+};
+
 class PerformanceState {
  public:
   explicit PerformanceState(v8::Isolate* isolate) :
@@ -68,6 +125,12 @@ class PerformanceState {
       isolate,
       offsetof(performance_state_internal, observers),
       NODE_PERFORMANCE_ENTRY_TYPE_INVALID,
+      root),
+    async_callback_stats(
+      isolate,
+      offsetof(performance_state_internal, async_callback_stats),
+      NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID *
+          NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS,
       root) {
     for (size_t i = 0; i < milestones.Length(); i++)
       milestones[i] = -1.;
@@ -76,9 +139,21 @@ class PerformanceState {
   AliasedUint8Array root;
   AliasedFloat64Array milestones;
   AliasedUint32Array observers;
+  // The number of callbacks and the time in nanoseconds spent in them, for
+  // each AsyncCallbackType. The time of nested callbacks is only accounted
+  // to the innermost one.
+  AliasedFloat64Array async_callback_stats;
 
   uint64_t performance_last_gc_start_mark = 0;
 
+  ThreadPoolWorkStats
+      threadpool_work_stats[NODE_PERFORMANCE_THREADPOOL_WORK_INVALID];
+
+  bool track_async_callbacks = false;
+  size_t current_async_callback = NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID;
+  double current_async_callback_id = -1;
+  uint64_t current_async_callback_start = 0;
+
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
 
@@ -86,10 +161,76 @@ class PerformanceState {
   struct performance_state_internal {
     // doubles first so that they are always sizeof(double)-aligned
     double milestones[NODE_PERFORMANCE_MILESTONE_INVALID];
+    double async_callback_stats[NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID *
+                                NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS];
     uint32_t observers[NODE_PERFORMANCE_ENTRY_TYPE_INVALID];
   };
 };
 
+// Accounts the time until it goes out of scope to a callback of the given
+// type, if async callback tracking is enabled. `async_id` is the id of the
+// resource making the callback, or -1 for the timer and immediate queues.
+class AsyncCallbackTimer {
+ public:
+  AsyncCallbackTimer() = default;
+  inline AsyncCallbackTimer(PerformanceState* state,
+                            size_t type,
+                            double async_id = -1) {
+    Start(state, type, async_id);
+  }
+
+  inline ~AsyncCallbackTimer() {
+    if (state_ == nullptr) return;
+    uint64_t now = PERFORMANCE_NOW();
+    Account(now);
+    state_->current_async_callback = previous_;
+    state_->current_async_callback_id = previous_id_;
+    state_->current_async_callback_start = now;
+  }
+
+  inline void Start(PerformanceState* state,
+                    size_t type,
+                    double async_id = -1) {
+    if (!state->track_async_callbacks) return;
+    // A callback that a resource makes from within its own callback scope,
+    // e.g. AsyncWrap::MakeCallback() inside of an InternalCallbackScope for
+    // the same AsyncWrap, is part of the callback that is already running.
+    if (async_id >= 0 && async_id == state->current_async_callback_id)
+      return;
+    CHECK_NULL(state_);
+    CHECK_LT(type, NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID);
+    state_ = state;
+    uint64_t now = PERFORMANCE_NOW();
+    // Pause the callback that this one is nested in, if any.
+    Account(now);
+    previous_ = state->current_async_callback;
+    previous_id_ = state->current_async_callback_id;
+    state->current_async_callback = type;
+    state->current_async_callback_id = async_id;
+    state->current_async_callback_start = now;
+    state->async_callback_stats[
+        type * NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS +
+        NODE_PERFORMANCE_ASYNC_CALLBACK_COUNT] += 1;
+  }
+
+  AsyncCallbackTimer(const AsyncCallbackTimer&) = delete;
+  AsyncCallbackTimer& operator=(const AsyncCallbackTimer&) = delete;
+
+ private:
+  inline void Account(uint64_t now) {
+    size_t current = state_->current_async_callback;
+    if (current == NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID) return;
+    state_->async_callback_stats[
+        current * NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS +
+        NODE_PERFORMANCE_ASYNC_CALLBACK_DURATION] +=
+            now - state_->current_async_callback_start;
+  }
+
+  PerformanceState* state_ = nullptr;
+  size_t previous_ = NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID;
+  double previous_id_ = -1;
+};
+
 }  // namespace performance
 }  // namespace node
 
@@ -3,9 +3,11 @@
 #include "node_report.h"
 #include "debug_utils-inl.h"
 #include "diagnosticfilename-inl.h"
+#include "histogram-inl.h"
 #include "node_internals.h"
 #include "node_metadata.h"
 #include "node_mutex.h"
+#include "node_perf.h"
 #include "node_worker.h"
 #include "util.h"
 
@@ -50,6 +52,7 @@ using v8::V8;
 using v8::Value;
 
 namespace per_process = node::per_process;
+namespace performance = node::performance;
 
 // Internal/static function declarations
 static void WriteNodeReport(Isolate* isolate,
@@ -70,6 +73,8 @@ static void PrintJavaScriptErrorProperties(JSONWriter* writer,
                                            Local<Object> error);
 static void PrintNativeStack(JSONWriter* writer);
 static void PrintResourceUsage(JSONWriter* writer);
+static void PrintAsyncCallbackStats(JSONWriter* writer, Environment* env);
+static void PrintThreadPoolWorkStats(JSONWriter* writer, Environment* env);
 static void PrintGCStatistics(JSONWriter* writer, Isolate* isolate);
 static void PrintSystemInformation(JSONWriter* writer);
 static void PrintLoadedLibraries(JSONWriter* writer);
@@ -305,6 +310,14 @@ static void WriteNodeReport(Isolate* isolate,
 
   writer.json_arrayend();
 
+  // Report time spent in callbacks, by async resource type
+  if (env != nullptr && env->performance_state()->track_async_callbacks)
+    PrintAsyncCallbackStats(&writer, env);
+
+  // Report latencies of work that this thread ran on the threadpool
+  if (env != nullptr)
+    PrintThreadPoolWorkStats(&writer, env);
+
   writer.json_arraystart("workers");
   if (env != nullptr) {
     Mutex workers_mutex;
@@ -660,6 +673,69 @@ static void PrintResourceUsage(JSONWriter* writer) {
 #endif
 }
 
+// Report the callbacks that were accounted for while tracking was enabled
+// through perf_hooks.monitorAsyncCallbacks().
+static void PrintAsyncCallbackStats(JSONWriter* writer, Environment* env) {
+  const node::AliasedFloat64Array& stats =
+      env->performance_state()->async_callback_stats;
+  writer->json_objectstart("asyncCallbacks");
+  for (size_t i = 0;
+       i < performance::NODE_PERFORMANCE_ASYNC_CALLBACK_INVALID;
+       i++) {
+    const size_t offset =
+        i * performance::NODE_PERFORMANCE_ASYNC_CALLBACK_FIELDS;
+    const uint64_t count = static_cast<uint64_t>(
+        stats[offset + performance::NODE_PERFORMANCE_ASYNC_CALLBACK_COUNT]);
+    if (count == 0) continue;
+    writer->json_objectstart(performance::GetAsyncCallbackTypeName(i));
+    writer->json_keyvalue("count", count);
+    writer->json_keyvalue(
+        "durationMs",
+        stats[offset + performance::NODE_PERFORMANCE_ASYNC_CALLBACK_DURATION] /
+            1e6);
+    writer->json_objectend();
+  }
+  writer->json_objectend();
+}
+
+static void PrintHistogram(JSONWriter* writer,
+                           const char* name,
+                           node::Histogram* histogram) {
+  writer->json_objectstart(name);
+  int64_t count = histogram->Count();
+  writer->json_keyvalue("count", count);
+  if (count > 0) {
+    writer->json_keyvalue("min", histogram->Min() / 1e6);
+    writer->json_keyvalue("max", histogram->Max() / 1e6);
+    writer->json_keyvalue("mean", histogram->Mean() / 1e6);
+    writer->json_keyvalue("p50", histogram->Percentile(50) / 1e6);
+    writer->json_keyvalue("p99", histogram->Percentile(99) / 1e6);
+  }
+  writer->json_objectend();
+}
+
+// Report the work that was submitted to the threadpool by type, with the
+// times in milliseconds.
+static void PrintThreadPoolWorkStats(JSONWriter* writer, Environment* env) {
+  writer->json_objectstart("threadpool");
+  for (size_t i = 0;
+       i < performance::NODE_PERFORMANCE_THREADPOOL_WORK_INVALID;
+       i++) {
+    performance::ThreadPoolWorkStats& stats =
+        env->performance_state()->threadpool_work_stats[i];
+    // Work of this type was never scheduled.
+    if (!stats.wait_time) continue;
+    writer->json_objectstart(performance::GetThreadPoolWorkTypeName(
+        static_cast<performance::ThreadPoolWorkType>(i)));
+    writer->json_keyvalue("queued", stats.queued.load());
+    writer->json_keyvalue("running", stats.running.load());
+    PrintHistogram(writer, "waitTimeMs", stats.wait_time.get());
+    PrintHistogram(writer, "runTimeMs", stats.run_time.get());
+    writer->json_objectend();
+  }
+  writer->json_objectend();
+}
+
 // Report operating system information.
 static void PrintSystemInformation(JSONWriter* writer) {
   uv_env_item_t* envitems;
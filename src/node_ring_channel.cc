@@ -0,0 +1,462 @@
+#include "node_ring_channel.h"
+
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_buffer.h"
+#include "node_errors.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#include <cstring>
+
+namespace node {
+
+using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
+using v8::Context;
+using v8::Float64Array;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Local;
+using v8::Object;
+using v8::Uint32;
+using v8::Uint8Array;
+using v8::Value;
+
+namespace worker {
+
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t ret = 64;  // Leave room for at least a few small records.
+  while (ret < value) ret <<= 1;
+  return ret;
+}
+
+}  // anonymous namespace
+
+RingChannelData::RingChannelData(size_t capacity)
+    : capacity_(RoundUpToPowerOfTwo(capacity)),
+      buffer_(new uint64_t[capacity_ / sizeof(uint64_t)]()) {
+  CHECK_LE(capacity_, static_cast<size_t>(kRecordLengthMask) + 1);
+}
+
+size_t RingChannelData::RecordSize(size_t length) {
+  return kHeaderSize + RoundUp(length, kHeaderSize);
+}
+
+size_t RingChannelData::max_record_length() const {
+  // A record of half the capacity always fits into an empty ring, no matter
+  // whether it has to be preceded by a padding record or not.
+  return capacity_ / 2 - kHeaderSize;
+}
+
+std::atomic<uint32_t>* RingChannelData::HeaderAt(uint64_t position) const {
+  char* base = reinterpret_cast<char*>(buffer_.get());
+  return reinterpret_cast<std::atomic<uint32_t>*>(
+      base + (position & (capacity_ - 1)));
+}
+
+bool RingChannelData::Write(const char* data, size_t length) {
+  CHECK_LE(length, max_record_length());
+  const size_t size = RecordSize(length);
+
+  uint64_t head;
+  size_t padding;
+  bool waiting = false;
+  for (;;) {
+    // Loading `tail_` first guarantees that `head` is not behind it.
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    head = head_.load(std::memory_order_relaxed);
+    const size_t space_to_end = capacity_ - (head & (capacity_ - 1));
+    padding = space_to_end < size ? space_to_end : 0;
+
+    if (head + padding + size - tail > capacity_) {
+      if (waiting) {
+        rejected_writes_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      // Ask the consumer to wake us up once it has made room, then look
+      // again in case it did so before it could see the flag.
+      producers_waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      waiting = true;
+      continue;
+    }
+
+    if (head_.compare_exchange_weak(head,
+                                    head + padding + size,
+                                    std::memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  // The space between `head` and `head + padding + size` is now owned by
+  // this thread. Fill it, then publish the headers so that the consumer
+  // can see the record.
+  const uint64_t position = head + padding;
+  std::atomic<uint32_t>* header = HeaderAt(position);
+  memcpy(reinterpret_cast<char*>(header) + kHeaderSize, data, length);
+  if (padding > 0) {
+    HeaderAt(head)->store(
+        kRecordReady | kRecordPadding |
+            static_cast<uint32_t>(padding - kHeaderSize),
+        std::memory_order_release);
+  }
+  header->store(kRecordReady | static_cast<uint32_t>(length),
+                std::memory_order_release);
+
+  bytes_written_.fetch_add(length, std::memory_order_relaxed);
+  records_written_.fetch_add(1, std::memory_order_relaxed);
+
+  // Only the write that makes the ring non-empty for a waiting consumer
+  // wakes it up; all other writes do not touch its event loop.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (consumer_waiting_.load(std::memory_order_relaxed) &&
+      consumer_waiting_.exchange(false)) {
+    NotifyConsumer();
+  }
+  return true;
+}
+
+const char* RingChannelData::Peek(size_t* length) {
+  bool waiting = false;
+  for (;;) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    std::atomic<uint32_t>* header = HeaderAt(tail);
+    const uint32_t value = header->load(std::memory_order_acquire);
+
+    if ((value & kRecordReady) == 0) {
+      if (waiting) return nullptr;
+      // Ask the producers to wake us up once the next record is complete,
+      // then look again in case it was completed before they could see the
+      // flag.
+      consumer_waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      waiting = true;
+      continue;
+    }
+
+    if (value & kRecordPadding) {
+      Consume(RecordSize(value & kRecordLengthMask));
+      continue;
+    }
+
+    if (waiting)
+      consumer_waiting_.store(false, std::memory_order_relaxed);
+    *length = value & kRecordLengthMask;
+    return reinterpret_cast<const char*>(header) + kHeaderSize;
+  }
+}
+
+void RingChannelData::Pop() {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint32_t value = HeaderAt(tail)->load(std::memory_order_relaxed);
+  CHECK_EQ(value & (kRecordReady | kRecordPadding), kRecordReady);
+  const size_t length = value & kRecordLengthMask;
+
+  bytes_read_.fetch_add(length, std::memory_order_relaxed);
+  records_read_.fetch_add(1, std::memory_order_relaxed);
+  Consume(RecordSize(length));
+}
+
+void RingChannelData::Consume(size_t size) {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  // Records never wrap around the end of the buffer. Clear this one, so that
+  // a later record that starts inside of it does not find a stale header.
+  memset(HeaderAt(tail), 0, size);
+  tail_.store(tail + size, std::memory_order_release);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (producers_waiting_.load(std::memory_order_relaxed) &&
+      producers_waiting_.exchange(false)) {
+    NotifyProducers();
+  }
+}
+
+void RingChannelData::NotifyConsumer() {
+  Mutex::ScopedLock lock(mutex_);
+  if (consumer_ != nullptr)
+    consumer_->TriggerAsync();
+}
+
+void RingChannelData::NotifyProducers() {
+  Mutex::ScopedLock lock(mutex_);
+  for (RingChannelHandle* producer : producers_)
+    producer->TriggerAsync();
+}
+
+void RingChannelData::AddProducer(RingChannelHandle* producer) {
+  Mutex::ScopedLock lock(mutex_);
+  producers_.insert(producer);
+}
+
+void RingChannelData::SetConsumer(RingChannelHandle* consumer) {
+  Mutex::ScopedLock lock(mutex_);
+  CHECK_NULL(consumer_);
+  consumer_ = consumer;
+}
+
+void RingChannelData::RemoveHandle(RingChannelHandle* handle) {
+  Mutex::ScopedLock lock(mutex_);
+  if (consumer_ == handle)
+    consumer_ = nullptr;
+  producers_.erase(handle);
+}
+
+void RingChannelData::GetStats(double* fields) const {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  fields[kRingChannelCapacity] = capacity_;
+  fields[kRingChannelBytesUsed] = head > tail ? head - tail : 0;
+  fields[kRingChannelBytesWritten] =
+      bytes_written_.load(std::memory_order_relaxed);
+  fields[kRingChannelRecordsWritten] =
+      records_written_.load(std::memory_order_relaxed);
+  fields[kRingChannelBytesRead] = bytes_read_.load(std::memory_order_relaxed);
+  fields[kRingChannelRecordsRead] =
+      records_read_.load(std::memory_order_relaxed);
+  fields[kRingChannelRejectedWrites] =
+      rejected_writes_.load(std::memory_order_relaxed);
+}
+
+RingChannelHandle::RingChannelHandle(Environment* env,
+                                     Local<Object> wrap,
+                                     std::shared_ptr<RingChannelData> data,
+                                     Role role)
+    : HandleWrap(env,
+                 wrap,
+                 reinterpret_cast<uv_handle_t*>(&async_),
+                 AsyncWrap::PROVIDER_RINGCHANNEL),
+      data_(std::move(data)),
+      role_(role) {
+  auto onasync = [](uv_async_t* handle) {
+    RingChannelHandle* wrap = ContainerOf(&RingChannelHandle::async_, handle);
+    wrap->OnAsync();
+  };
+  CHECK_EQ(uv_async_init(env->event_loop(), &async_, onasync), 0);
+
+  if (role_ == Role::kConsumer) {
+    data_->SetConsumer(this);
+    // The ring may already contain records, e.g. when the consumer has been
+    // transferred from another thread.
+    TriggerAsync();
+  } else {
+    // Producers only use their handle for emitting 'drain', which should not
+    // keep the event loop alive on its own.
+    uv_unref(reinterpret_cast<uv_handle_t*>(&async_));
+    data_->AddProducer(this);
+  }
+}
+
+RingChannelHandle::~RingChannelHandle() {
+  data_->RemoveHandle(this);
+}
+
+Local<FunctionTemplate> RingChannelHandle::GetConstructorTemplate(
+    Environment* env) {
+  Local<FunctionTemplate> tmpl =
+      env->ring_channel_handle_constructor_template();
+  if (tmpl.IsEmpty()) {
+    tmpl = FunctionTemplate::New(env->isolate());
+    tmpl->InstanceTemplate()->SetInternalFieldCount(
+        RingChannelHandle::kInternalFieldCount);
+    tmpl->Inherit(HandleWrap::GetConstructorTemplate(env));
+    tmpl->SetClassName(
+        FIXED_ONE_BYTE_STRING(env->isolate(), "RingChannelHandle"));
+    env->SetProtoMethod(tmpl, "write", Write);
+    env->SetProtoMethod(tmpl, "read", Read);
+    env->SetProtoMethod(tmpl, "getStats", GetStats);
+    env->set_ring_channel_handle_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+RingChannelHandle* RingChannelHandle::New(
+    Environment* env,
+    Local<Context> context,
+    std::shared_ptr<RingChannelData> data,
+    Role role) {
+  Context::Scope context_scope(context);
+  Local<Object> instance;
+  if (!GetConstructorTemplate(env)->InstanceTemplate()
+           ->NewInstance(context).ToLocal(&instance)) {
+    return nullptr;
+  }
+  return new RingChannelHandle(env, instance, std::move(data), role);
+}
+
+void RingChannelHandle::TriggerAsync() {
+  if (IsHandleClosing()) return;
+  CHECK_EQ(uv_async_send(&async_), 0);
+}
+
+void RingChannelHandle::Close(Local<Value> close_callback) {
+  // Once this returns, no other thread will call TriggerAsync() on this
+  // handle anymore.
+  data_->RemoveHandle(this);
+  HandleWrap::Close(close_callback);
+}
+
+void RingChannelHandle::OnAsync() {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+
+  if (role_ == Role::kConsumer) {
+    // Peek() also asks to be woken up again if the ring is still empty,
+    // e.g. after a spurious wakeup.
+    size_t length;
+    if (data_->Peek(&length) == nullptr) return;
+    Debug(this, "Ring channel has a record of %d bytes", length);
+    MakeCallback(env()->onreadable_string(), 0, nullptr);
+  } else {
+    if (!needs_drain_) return;
+    needs_drain_ = false;
+    MakeCallback(env()->ondrain_string(), 0, nullptr);
+  }
+}
+
+void RingChannelHandle::CreateRingChannel(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());  // capacity
+  Local<Context> context = env->context();
+
+  auto data = std::make_shared<RingChannelData>(args[0].As<Uint32>()->Value());
+  RingChannelHandle* producer = New(env, context, data, Role::kProducer);
+  if (producer == nullptr) return;
+  RingChannelHandle* consumer = New(env, context, data, Role::kConsumer);
+  if (consumer == nullptr) {
+    producer->Close();
+    return;
+  }
+
+  Local<Value> handles[] = { producer->object(), consumer->object() };
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), handles, arraysize(handles)));
+}
+
+void RingChannelHandle::Write(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RingChannelHandle* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_EQ(wrap->role_, Role::kProducer);
+  CHECK(args[0]->IsArrayBufferView());
+
+  ArrayBufferViewContents<char> record(args[0]);
+  if (record.length() > wrap->data_->max_record_length()) {
+    THROW_ERR_OUT_OF_RANGE(
+        env, "The record must not be larger than half of the capacity");
+    return;
+  }
+
+  if (wrap->IsHandleClosing())
+    return args.GetReturnValue().Set(false);
+
+  const bool written = wrap->data_->Write(record.data(), record.length());
+  if (!written)
+    wrap->needs_drain_ = true;
+  args.GetReturnValue().Set(written);
+}
+
+void RingChannelHandle::Read(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RingChannelHandle* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_EQ(wrap->role_, Role::kConsumer);
+  if (wrap->IsHandleClosing()) return;
+
+  size_t length;
+  const char* record = wrap->data_->Peek(&length);
+  if (record == nullptr) return;
+
+  std::unique_ptr<BackingStore> store =
+      ArrayBuffer::NewBackingStore(env->isolate(), length);
+  if (length > 0)
+    memcpy(store->Data(), record, length);
+  wrap->data_->Pop();
+
+  Local<ArrayBuffer> ab = ArrayBuffer::New(env->isolate(), std::move(store));
+  Local<Uint8Array> buffer;
+  if (Buffer::New(env, ab, 0, length).ToLocal(&buffer))
+    args.GetReturnValue().Set(buffer);
+}
+
+void RingChannelHandle::GetStats(const FunctionCallbackInfo<Value>& args) {
+  RingChannelHandle* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), kRingChannelStatsFieldsCount);
+
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+  wrap->data_->GetStats(fields);
+}
+
+BaseObject::TransferMode RingChannelHandle::GetTransferMode() const {
+  if (IsHandleClosing())
+    return TransferMode::kUntransferable;
+  return role_ == Role::kProducer ?
+      TransferMode::kCloneable : TransferMode::kTransferable;
+}
+
+std::unique_ptr<TransferData> RingChannelHandle::TransferForMessaging() {
+  auto ret = std::make_unique<Data>(data_, role_);
+  Close();
+  return ret;
+}
+
+std::unique_ptr<TransferData> RingChannelHandle::CloneForMessaging() const {
+  CHECK_EQ(role_, Role::kProducer);
+  return std::make_unique<Data>(data_, role_);
+}
+
+void RingChannelHandle::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("ring", data_->capacity());
+}
+
+RingChannelHandle::Data::Data(std::shared_ptr<RingChannelData> data,
+                              Role role)
+    : data_(std::move(data)), role_(role) {}
+
+BaseObjectPtr<BaseObject> RingChannelHandle::Data::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<TransferData> self) {
+  if (context != env->context()) {
+    THROW_ERR_MESSAGE_TARGET_CONTEXT_UNAVAILABLE(env);
+    return {};
+  }
+
+  RingChannelHandle* handle =
+      RingChannelHandle::New(env, context, std::move(data_), role_);
+  if (handle == nullptr) return {};
+  return BaseObjectPtr<BaseObject> { handle };
+}
+
+void RingChannelHandle::Initialize(Local<Object> target,
+                                   Local<Value> unused,
+                                   Local<Context> context,
+                                   void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  env->SetMethod(target, "createRingChannel", CreateRingChannel);
+
+  Local<Object> constants = Object::New(env->isolate());
+  NODE_DEFINE_CONSTANT(constants, kRingChannelStatsFieldsCount);
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "constants"),
+              constants).Check();
+}
+
+}  // namespace worker
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(ring_channel,
+                                   node::worker::RingChannelHandle::Initialize)
@@ -0,0 +1,198 @@
+#ifndef SRC_NODE_RING_CHANNEL_H_
+#define SRC_NODE_RING_CHANNEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "handle_wrap.h"
+#include "node_messaging.h"
+#include "node_mutex.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <atomic>
+#include <memory>
+#include <unordered_set>
+
+namespace node {
+namespace worker {
+
+class RingChannelHandle;
+
+// Keep in sync with the constants in lib/internal/worker/ring_channel.js.
+enum RingChannelStatsFields {
+  kRingChannelCapacity,
+  kRingChannelBytesUsed,
+  kRingChannelBytesWritten,
+  kRingChannelRecordsWritten,
+  kRingChannelBytesRead,
+  kRingChannelRecordsRead,
+  kRingChannelRejectedWrites,
+  kRingChannelStatsFieldsCount
+};
+
+// A fixed-size ring buffer of variable-length records that is shared between
+// threads. Any number of producers may write records into it concurrently,
+// and a single consumer reads them in the order in which space for them was
+// reserved. Neither writing nor reading takes a lock; the mutex only protects
+// the set of handles that are woken up through their uv_async_t when the
+// consumer has something to read or the producers have room to write again.
+class RingChannelData {
+ public:
+  // `capacity` is rounded up to a power of two.
+  explicit RingChannelData(size_t capacity);
+
+  RingChannelData(const RingChannelData&) = delete;
+  RingChannelData& operator=(const RingChannelData&) = delete;
+
+  // Copy a record into the ring. Returns false if there is currently not
+  // enough free space for it, in which case the registered producers are
+  // woken up once the consumer has made room. This may be called from any
+  // thread.
+  bool Write(const char* data, size_t length);
+
+  // Return the oldest record in the ring without removing it, or nullptr
+  // if there is no complete record yet, in which case the consumer is woken
+  // up once there is one. Peek() and Pop() may only be called from the
+  // thread that owns the consumer.
+  const char* Peek(size_t* length);
+  // Remove the record returned by the last call to Peek().
+  void Pop();
+
+  void AddProducer(RingChannelHandle* producer);
+  void SetConsumer(RingChannelHandle* consumer);
+  // Stop notifying `handle`. This is thread-safe, and has to be because
+  // handles are closed on their own threads.
+  void RemoveHandle(RingChannelHandle* handle);
+
+  void GetStats(double* fields) const;
+
+  size_t capacity() const { return capacity_; }
+  // The largest record that fits into the ring.
+  size_t max_record_length() const;
+
+ private:
+  // Every record starts with an 8-byte header, of which the first 4 bytes
+  // hold the payload length and the flags below, and is padded to a multiple
+  // of 8 bytes. A record that does not fit before the end of the buffer is
+  // preceded by a padding record that covers the rest of the buffer.
+  static constexpr size_t kHeaderSize = 8;
+  static constexpr uint32_t kRecordReady = 1u << 31;
+  static constexpr uint32_t kRecordPadding = 1u << 30;
+  static constexpr uint32_t kRecordLengthMask = kRecordPadding - 1;
+
+  static size_t RecordSize(size_t length);
+  std::atomic<uint32_t>* HeaderAt(uint64_t position) const;
+  void Consume(size_t size);
+  void NotifyConsumer();
+  void NotifyProducers();
+
+  const size_t capacity_;
+  std::unique_ptr<uint64_t[]> buffer_;
+
+  // Positions are counted in bytes since the creation of the ring and only
+  // ever increase. `head_` is the end of the space reserved by producers,
+  // `tail_` the start of the oldest record that has not been read yet.
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
+  // Set by the consumer when it found no complete record, and by producers
+  // when they found no room for a record, respectively.
+  std::atomic<bool> consumer_waiting_{true};
+  std::atomic<bool> producers_waiting_{false};
+
+  std::atomic<uint64_t> bytes_written_{0};
+  std::atomic<uint64_t> records_written_{0};
+  std::atomic<uint64_t> bytes_read_{0};
+  std::atomic<uint64_t> records_read_{0};
+  std::atomic<uint64_t> rejected_writes_{0};
+
+  // This mutex protects the fields below it.
+  Mutex mutex_;
+  RingChannelHandle* consumer_ = nullptr;
+  std::unordered_set<RingChannelHandle*> producers_;
+};
+
+// One end of a ring channel, i.e. either a producer or the consumer.
+// The uv_async_t is used to wake up the event loop of the thread that owns
+// this handle; for the consumer that means calling `onreadable`, for a
+// producer that previously failed to write a record, calling `ondrain`.
+class RingChannelHandle : public HandleWrap {
+ public:
+  enum class Role { kProducer, kConsumer };
+
+  ~RingChannelHandle() override;
+
+  static void Initialize(v8::Local<v8::Object> target,
+                         v8::Local<v8::Value> unused,
+                         v8::Local<v8::Context> context,
+                         void* priv);
+
+  // Create a new handle for `data`, in the Context `context`.
+  static RingChannelHandle* New(Environment* env,
+                                v8::Local<v8::Context> context,
+                                std::shared_ptr<RingChannelData> data,
+                                Role role);
+
+  static void CreateRingChannel(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Write(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetStats(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Called by RingChannelData while holding its mutex.
+  void TriggerAsync();
+
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  // Producers are cloned, so that there can be one in every thread that
+  // wants to write into the ring. The consumer can only be transferred.
+  TransferMode GetTransferMode() const override;
+  std::unique_ptr<TransferData> TransferForMessaging() override;
+  std::unique_ptr<TransferData> CloneForMessaging() const override;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(RingChannelHandle)
+  SET_SELF_SIZE(RingChannelHandle)
+
+  class Data : public TransferData {
+   public:
+    Data(std::shared_ptr<RingChannelData> data, Role role);
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<TransferData> self) override;
+
+    SET_NO_MEMORY_INFO()
+    SET_MEMORY_INFO_NAME(RingChannelHandleTransferData)
+    SET_SELF_SIZE(Data)
+
+   private:
+    std::shared_ptr<RingChannelData> data_;
+    Role role_;
+  };
+
+ private:
+  RingChannelHandle(Environment* env,
+                    v8::Local<v8::Object> wrap,
+                    std::shared_ptr<RingChannelData> data,
+                    Role role);
+
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+
+  void OnAsync();
+
+  std::shared_ptr<RingChannelData> data_;
+  const Role role_;
+  // Whether this producer failed to write a record since the last `ondrain`.
+  bool needs_drain_ = false;
+  uv_async_t async_;
+};
+
+}  // namespace worker
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_RING_CHANNEL_H_
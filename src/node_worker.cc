@@ -4,15 +4,29 @@
 #include "memory_tracker-inl.h"
 #include "node_errors.h"
 #include "node_buffer.h"
+#include "node_main_instance.h"
 #include "node_options-inl.h"
 #include "node_perf.h"
 #include "util-inl.h"
 #include "async_wrap-inl.h"
 
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <pthread.h>
+#endif
+
 using node::kAllowedInEnvironment;
 using node::kDisallowedInEnvironment;
 using v8::Array;
@@ -42,6 +56,10 @@ namespace worker {
 
 constexpr double kMB = 1024 * 1024;
 
+// The embedded snapshot does not contain any external references yet,
+// see Start() in src/node.cc.
+static const intptr_t snapshot_external_references[] = { 0 };
+
 Worker::Worker(Environment* env,
                Local<Object> wrap,
                const std::string& url,
@@ -121,6 +139,209 @@ void Worker::UpdateResourceConstraints(ResourceConstraints* constraints) {
   }
 }
 
+#ifdef __linux__
+// Parses a CPU list like "0-3,8-11", as found in
+// /sys/devices/system/node/node<N>/cpulist.
+static bool ParseCPUList(const std::string& list, cpu_set_t* cpus) {
+  CPU_ZERO(cpus);
+  const char* p = list.c_str();
+  while (*p != '\0' && *p != '\n') {
+    char* end;
+    const long first = strtol(p, &end, 10);  // NOLINT(runtime/int)
+    if (end == p) return false;
+    long last = first;  // NOLINT(runtime/int)
+    p = end;
+    if (*p == '-') {
+      last = strtol(p + 1, &end, 10);
+      if (end == p + 1) return false;
+      p = end;
+    }
+    for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)  // NOLINT
+      CPU_SET(cpu, cpus);
+    if (*p == ',') p++;
+  }
+  return CPU_COUNT(cpus) > 0;
+}
+#endif  // __linux__
+
+void Worker::ApplySchedulingOptions() {
+#ifdef __linux__
+  const double niceness = scheduling_options_[kNiceness];
+  const double policy = scheduling_options_[kSchedulingPolicy];
+  const double numa_node = scheduling_options_[kNumaNode];
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int cpu : cpu_affinity_)
+    CPU_SET(cpu, &cpus);
+
+  if (!std::isnan(numa_node)) {
+    const int node = static_cast<int>(numa_node);
+    std::string cpulist;
+    cpu_set_t node_cpus;
+    const std::string path =
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+    if (ReadFileSync(&cpulist, path.c_str()) == 0 &&
+        ParseCPUList(cpulist, &node_cpus)) {
+      // Explicitly listed CPUs are narrowed down to the ones on the node,
+      // unless none of them are on it.
+      cpu_set_t both;
+      CPU_AND(&both, &cpus, &node_cpus);
+      if (cpu_affinity_.empty())
+        cpus = node_cpus;
+      else if (CPU_COUNT(&both) > 0)
+        cpus = both;
+    } else {
+      Debug(this, "Worker %llu could not read the CPUs of NUMA node %d",
+            thread_id_.id, node);
+    }
+
+#ifdef SYS_set_mempolicy
+    // Prefer allocating memory on that node, like numa_set_preferred() does.
+    // MPOL_PREFERRED is 1 in <linux/mempolicy.h>.
+    constexpr int kMpolPreferred = 1;
+    constexpr size_t kBitsPerLong = sizeof(unsigned long) * 8;  // NOLINT
+    unsigned long nodemask[1024 / kBitsPerLong] = {};  // NOLINT(runtime/int)
+    if (node < 1024) {
+      nodemask[node / kBitsPerLong] |= 1UL << (node % kBitsPerLong);
+      if (syscall(SYS_set_mempolicy, kMpolPreferred, nodemask,
+                  sizeof(nodemask) * 8 + 1) != 0) {
+        Debug(this, "Worker %llu could not prefer NUMA node %d: %s",
+              thread_id_.id, node, strerror(errno));
+      }
+    }
+#endif  // SYS_set_mempolicy
+  }
+
+  if (CPU_COUNT(&cpus) > 0) {
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (err != 0) {
+      Debug(this, "Worker %llu could not set its CPU affinity: %s",
+            thread_id_.id, strerror(err));
+    }
+  }
+
+  if (!std::isnan(policy)) {
+    int native_policy = SCHED_OTHER;
+    if (policy == kSchedulingPolicyBatch)
+      native_policy = SCHED_BATCH;
+    else if (policy == kSchedulingPolicyIdle)
+      native_policy = SCHED_IDLE;
+    sched_param param {};
+    int err = pthread_setschedparam(pthread_self(), native_policy, &param);
+    if (err != 0) {
+      Debug(this, "Worker %llu could not set its scheduling policy: %s",
+            thread_id_.id, strerror(err));
+    }
+  }
+
+  // On Linux, the niceness of a thread can be set through its kernel id.
+  if (!std::isnan(niceness) &&
+      setpriority(PRIO_PROCESS,
+                  static_cast<id_t>(syscall(SYS_gettid)),
+                  static_cast<int>(niceness)) != 0) {
+    Debug(this, "Worker %llu could not set its niceness: %s",
+          thread_id_.id, strerror(errno));
+  }
+#elif defined(_WIN32)
+  const double niceness = scheduling_options_[kNiceness];
+
+  if (!cpu_affinity_.empty()) {
+    // Only the CPUs of the current processor group can be selected here.
+    constexpr int kMaskBits = sizeof(DWORD_PTR) * 8;
+    DWORD_PTR mask = 0;
+    for (int cpu : cpu_affinity_) {
+      if (cpu < kMaskBits)
+        mask |= DWORD_PTR{1} << cpu;
+    }
+    if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+      Debug(this, "Worker %llu could not set its CPU affinity",
+            thread_id_.id);
+    }
+  }
+
+  if (!std::isnan(niceness)) {
+    // Map niceness to thread priorities the way uv_os_setpriority() maps it
+    // to process priority classes.
+    int priority;
+    if (niceness < UV_PRIORITY_HIGH)
+      priority = THREAD_PRIORITY_HIGHEST;
+    else if (niceness < UV_PRIORITY_ABOVE_NORMAL)
+      priority = THREAD_PRIORITY_ABOVE_NORMAL;
+    else if (niceness < UV_PRIORITY_BELOW_NORMAL)
+      priority = THREAD_PRIORITY_NORMAL;
+    else if (niceness < UV_PRIORITY_LOW)
+      priority = THREAD_PRIORITY_BELOW_NORMAL;
+    else
+      priority = THREAD_PRIORITY_LOWEST;
+    if (!SetThreadPriority(GetCurrentThread(), priority)) {
+      Debug(this, "Worker %llu could not set its priority", thread_id_.id);
+    }
+  }
+#endif
+  // Other platforms do not support any of these options, and the scheduling
+  // policy and NUMA node are only supported on Linux.
+}
+
+// Reads the user and system CPU time that `thread` has used so far into
+// `fields`, in microseconds. Returns 0 or a libuv error code.
+int Worker::ReadThreadCPUUsage(uv_thread_t thread, double* fields) const {
+#ifdef __linux__
+  // The kernel id is used instead of `thread` here, since there is no way
+  // to query another thread's rusage through pthreads.
+  std::string stat;
+  const std::string path =
+      "/proc/self/task/" + std::to_string(native_thread_id_) + "/stat";
+  int err = ReadFileSync(&stat, path.c_str());
+  if (err != 0) return err;
+  // The command name may contain spaces and parentheses, so skip past the
+  // last ')' before scanning for utime and stime (fields 14 and 15).
+  const size_t comm_end = stat.rfind(')');
+  if (comm_end == std::string::npos) return UV_EINVAL;
+  unsigned long long utime, stime;  // NOLINT(runtime/int)
+  if (sscanf(stat.c_str() + comm_end + 1,
+             " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu",
+             &utime, &stime) != 2) {
+    return UV_EINVAL;
+  }
+  static const double ticks_per_second = sysconf(_SC_CLK_TCK);
+  fields[0] = utime * 1e6 / ticks_per_second;
+  fields[1] = stime * 1e6 / ticks_per_second;
+  return 0;
+#elif defined(__APPLE__)
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+  if (thread_info(pthread_mach_thread_np(thread),
+                  THREAD_BASIC_INFO,
+                  reinterpret_cast<thread_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+    return UV_EINVAL;
+  }
+  fields[0] = 1e6 * info.user_time.seconds + info.user_time.microseconds;
+  fields[1] = 1e6 * info.system_time.seconds + info.system_time.microseconds;
+  return 0;
+#elif defined(_WIN32)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(thread,
+                      &creation_time,
+                      &exit_time,
+                      &kernel_time,
+                      &user_time)) {
+    return UV_EINVAL;
+  }
+  // FILETIME values are in units of 100 nanoseconds.
+  auto to_micros = [](const FILETIME& time) {
+    return ((static_cast<uint64_t>(time.dwHighDateTime) << 32) |
+            time.dwLowDateTime) / 10.0;
+  };
+  fields[0] = to_micros(user_time);
+  fields[1] = to_micros(kernel_time);
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
 // This class contains data that is only relevant to the child thread itself,
 // and only while it is running.
 // (Eventually, the Environment instance should probably also be moved here.)
@@ -144,6 +365,17 @@ class WorkerThreadData {
     SetIsolateCreateParamsForNode(&params);
     params.array_buffer_allocator_shared = allocator;
 
+    // Like the main instance, start from the embedded snapshot if possible.
+    // It contains the per-Isolate data and a base context with the
+    // per-context scripts already run, so that Worker::Run() only needs to
+    // deserialize that context instead of creating it from scratch.
+    const std::vector<size_t>* indexes = nullptr;
+    if (w->use_node_snapshot_) {
+      params.snapshot_blob = NodeMainInstance::GetEmbeddedSnapshotBlob();
+      params.external_references = snapshot_external_references;
+      indexes = NodeMainInstance::GetIsolateDataIndexes();
+    }
+
     w->UpdateResourceConstraints(&params.constraints);
 
     Isolate* isolate = Isolate::Allocate();
@@ -156,7 +388,13 @@ class WorkerThreadData {
 
     w->platform_->RegisterIsolate(isolate, &loop_);
     Isolate::Initialize(isolate, params);
-    SetIsolateUpForNode(isolate);
+    if (w->use_node_snapshot_) {
+      // The error handlers are set up after the context has been
+      // deserialized in Worker::Run(), like for the main instance.
+      SetIsolateMiscHandlers(isolate, {});
+    } else {
+      SetIsolateUpForNode(isolate);
+    }
 
     // Be sure it's called before Environment::InitializeDiagnostics()
     // so that this callback stays when the callback of
@@ -171,10 +409,11 @@ class WorkerThreadData {
       isolate->SetStackLimit(w->stack_base_);
 
       HandleScope handle_scope(isolate);
-      isolate_data_.reset(CreateIsolateData(isolate,
-                                            &loop_,
-                                            w_->platform_,
-                                            allocator.get()));
+      isolate_data_.reset(new IsolateData(isolate,
+                                          &loop_,
+                                          w_->platform_,
+                                          allocator.get(),
+                                          indexes));
       CHECK(isolate_data_);
       if (w_->per_isolate_opts_)
         isolate_data_->set_options(std::move(w_->per_isolate_opts_));
@@ -298,7 +537,16 @@ void Worker::Run() {
         // resource constraints, we need something in place to handle it,
         // though.
         TryCatch try_catch(isolate_);
-        context = NewContext(isolate_);
+        if (use_node_snapshot_) {
+          if (Context::FromSnapshot(isolate_,
+                                    NodeMainInstance::kNodeContextIndex)
+                  .ToLocal(&context)) {
+            InitializeContextRuntime(context);
+            SetIsolateErrorHandlers(isolate_, {});
+          }
+        } else {
+          context = NewContext(isolate_);
+        }
         if (context.IsEmpty()) {
           // TODO(addaleax): This should be ERR_WORKER_INIT_FAILED,
           // ERR_WORKER_OUT_OF_MEMORY is for reaching the per-Worker heap limit.
@@ -602,6 +850,29 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
   limit_info->CopyContents(worker->resource_limits_,
                            sizeof(worker->resource_limits_));
 
+  CHECK(args[5]->IsFloat64Array());
+  Local<Float64Array> scheduling_info = args[5].As<Float64Array>();
+  CHECK_EQ(scheduling_info->Length(), kTotalSchedulingOptionCount);
+  scheduling_info->CopyContents(worker->scheduling_options_,
+                                sizeof(worker->scheduling_options_));
+
+  if (args[6]->IsArray()) {
+    Local<Array> cpus = args[6].As<Array>();
+    for (uint32_t i = 0; i < cpus->Length(); i++) {
+      Local<Value> cpu;
+      if (!cpus->Get(env->context(), i).ToLocal(&cpu)) return;
+      CHECK(cpu->IsInt32());
+      worker->cpu_affinity_.push_back(cpu.As<v8::Int32>()->Value());
+    }
+  }
+
+  // Use the embedded snapshot if the parent does, unless it has been
+  // disabled through the Worker's own options.
+  worker->use_node_snapshot_ =
+      env->isolate_data()->options()->node_snapshot &&
+      (!per_isolate_opts || per_isolate_opts->node_snapshot) &&
+      NodeMainInstance::GetEmbeddedSnapshotBlob() != nullptr;
+
   CHECK(args[4]->IsBoolean());
   if (args[4]->IsTrue() || env->tracks_unmanaged_fds())
     worker->environment_flags_ |= EnvironmentFlags::kTrackUnmanagedFds;
@@ -641,9 +912,23 @@ void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
     // some space to do work in C++ land.
     w->stack_base_ = stack_top - (w->stack_size_ - kStackBufferSize);
 
+    {
+      Mutex::ScopedLock lock(w->mutex_);
+#ifdef __linux__
+      w->native_thread_id_ = syscall(SYS_gettid);
+#endif
+      w->thread_started_ = true;
+    }
+    w->ApplySchedulingOptions();
+
     w->Run();
 
     Mutex::ScopedLock lock(w->mutex_);
+    // Keep the final CPU usage around, since it cannot be read anymore
+    // once the thread is gone.
+    if (w->ReadThreadCPUUsage(uv_thread_self(), w->cpu_usage_) != 0)
+      w->cpu_usage_[0] = w->cpu_usage_[1] = 0;
+    w->thread_finished_ = true;
     w->env()->SetImmediateThreadsafe(
         [w = std::unique_ptr<Worker>(w)](Environment* env) {
           if (w->has_ref_)
@@ -792,6 +1077,34 @@ void Worker::TakeHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(scheduled ? taker->object() : Local<Object>());
 }
 
+void Worker::CPUUsage(const FunctionCallbackInfo<Value>& args) {
+  Worker* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
+
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 2);
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+
+  Mutex::ScopedLock lock(w->mutex_);
+  if (w->thread_finished_ || !w->thread_started_) {
+    fields[0] = w->cpu_usage_[0];
+    fields[1] = w->cpu_usage_[1];
+    return;
+  }
+
+  // The thread cannot finish while the mutex is held, so tid_ stays valid.
+  int err = w->ReadThreadCPUUsage(w->tid_, fields);
+  if (err != 0) {
+    // On error, return the strerror version of the error code, like
+    // process.cpuUsage() does.
+    Local<String> errmsg = OneByteString(args.GetIsolate(), uv_strerror(err));
+    return args.GetReturnValue().Set(errmsg);
+  }
+}
+
 void Worker::LoopIdleTime(const FunctionCallbackInfo<Value>& args) {
   Worker* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
@@ -860,6 +1173,7 @@ void InitWorker(Local<Object> target,
     env->SetProtoMethod(w, "takeHeapSnapshot", Worker::TakeHeapSnapshot);
     env->SetProtoMethod(w, "loopIdleTime", Worker::LoopIdleTime);
     env->SetProtoMethod(w, "loopStartTime", Worker::LoopStartTime);
+    env->SetProtoMethod(w, "cpuUsage", Worker::CPUUsage);
 
     env->SetConstructorFunction(target, "Worker", w);
   }
@@ -910,6 +1224,14 @@ void InitWorker(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kCodeRangeSizeMb);
   NODE_DEFINE_CONSTANT(target, kStackSizeMb);
   NODE_DEFINE_CONSTANT(target, kTotalResourceLimitCount);
+
+  NODE_DEFINE_CONSTANT(target, kNiceness);
+  NODE_DEFINE_CONSTANT(target, kSchedulingPolicy);
+  NODE_DEFINE_CONSTANT(target, kNumaNode);
+  NODE_DEFINE_CONSTANT(target, kTotalSchedulingOptionCount);
+  NODE_DEFINE_CONSTANT(target, kSchedulingPolicyOther);
+  NODE_DEFINE_CONSTANT(target, kSchedulingPolicyBatch);
+  NODE_DEFINE_CONSTANT(target, kSchedulingPolicyIdle);
 }
 
 }  // anonymous namespace
@@ -20,6 +20,19 @@ enum ResourceLimits {
   kTotalResourceLimitCount
 };
 
+enum SchedulingOptions {
+  kNiceness,
+  kSchedulingPolicy,
+  kNumaNode,
+  kTotalSchedulingOptionCount
+};
+
+enum SchedulingPolicy {
+  kSchedulingPolicyOther,
+  kSchedulingPolicyBatch,
+  kSchedulingPolicyIdle
+};
+
 // A worker thread, as represented in its parent thread.
 class Worker : public AsyncWrap {
  public:
@@ -68,6 +81,7 @@ class Worker : public AsyncWrap {
   static void TakeHeapSnapshot(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void LoopIdleTime(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void LoopStartTime(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CPUUsage(const v8::FunctionCallbackInfo<v8::Value>& args);
 
  private:
   bool CreateEnvMessagePort(Environment* env);
@@ -98,6 +112,21 @@ class Worker : public AsyncWrap {
   double resource_limits_[kTotalResourceLimitCount];
   void UpdateResourceConstraints(v8::ResourceConstraints* constraints);
 
+  // Scheduling options, applied by the worker thread itself when it starts.
+  // Unset entries are NaN.
+  double scheduling_options_[kTotalSchedulingOptionCount];
+  std::vector<int> cpu_affinity_;
+  void ApplySchedulingOptions();
+
+  // CPU time used by the worker thread, in microseconds. While the thread
+  // is running, this is read on demand; the thread stores the final value
+  // right before it exits.
+  bool thread_started_ = false;
+  bool thread_finished_ = false;
+  int64_t native_thread_id_ = 0;
+  double cpu_usage_[2] = { 0, 0 };
+  int ReadThreadCPUUsage(uv_thread_t thread, double* fields) const;
+
   // Full size of the thread's stack.
   size_t stack_size_ = 4 * 1024 * 1024;
   // Stack buffer size that is not available to the JS engine.
@@ -117,6 +146,9 @@ class Worker : public AsyncWrap {
   bool stopped_ = true;
 
   bool has_ref_ = true;
+  // Whether the Isolate and Context are deserialized from the embedded
+  // snapshot rather than created from scratch.
+  bool use_node_snapshot_ = false;
   uint64_t environment_flags_ = EnvironmentFlags::kNoFlags;
 
   // The real Environment of the worker object. It has a lesser
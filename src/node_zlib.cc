@@ -252,7 +252,8 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  public:
   CompressionStream(Environment* env, Local<Object> wrap)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
-        ThreadPoolWork(env),
+        ThreadPoolWork(env,
+                       performance::NODE_PERFORMANCE_THREADPOOL_WORK_ZLIB),
         write_result_(nullptr) {
     MakeWeak();
   }
@@ -25,21 +25,50 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "util-inl.h"
+#include "env-inl.h"
+#include "histogram-inl.h"
 #include "node_internals.h"
 
 namespace node {
 
+ThreadPoolWork::ThreadPoolWork(Environment* env,
+                               performance::ThreadPoolWorkType type)
+    : env_(env) {
+  CHECK_NOT_NULL(env);
+  CHECK_LT(type, performance::NODE_PERFORMANCE_THREADPOOL_WORK_INVALID);
+  stats_ = &env->performance_state()->threadpool_work_stats[type];
+}
+
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
+  if (stats_ != nullptr) {
+    stats_->EnsureHistograms();
+    stats_->queued++;
+    queued_at_ = uv_hrtime();
+  }
   int status = uv_queue_work(
       env_->event_loop(),
       &work_req_,
       [](uv_work_t* req) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
+        performance::ThreadPoolWorkStats* stats = self->stats_;
+        if (stats == nullptr) {
+          self->DoThreadPoolWork();
+          return;
+        }
+        uint64_t start = uv_hrtime();
+        stats->wait_time->Record(start - self->queued_at_);
+        stats->queued--;
+        stats->running++;
         self->DoThreadPoolWork();
+        stats->run_time->Record(uv_hrtime() - start);
+        stats->running--;
       },
       [](uv_work_t* req, int status) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
+        // Work that was cancelled never reached a thread.
+        if (status == UV_ECANCELED && self->stats_ != nullptr)
+          self->stats_->queued--;
         self->env_->DecreaseWaitingRequestCounter();
         self->AfterThreadPoolWork(status);
       });
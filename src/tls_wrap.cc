@@ -27,6 +27,7 @@
 #include "node_buffer.h"  // Buffer
 #include "node_crypto.h"  // SecureContext
 #include "node_crypto_bio.h"  // NodeBIO
+#include "node_crypto_common.h"  // UseSNIContext
 // ClientHelloParser
 #include "node_crypto_clienthello-inl.h"
 #include "node_errors.h"
@@ -1087,6 +1088,19 @@ int TLSWrap::SelectSNIContextCallback(SSL* s, int* ad, void* arg) {
     return SSL_TLSEXT_ERR_NOACK;
   }
 
+  // Prefer the native certificate store, if any, over the JS SNI context so
+  // that the common case does not need to call into JS at all.
+  crypto::SNICertStore* store = p->sc_->sni_cert_store_.get();
+  if (store != nullptr) {
+    SSL_CTX* sni_ctx = store->Lookup(servername);
+    if (sni_ctx != nullptr) {
+      if (crypto::UseSNIContext(p->ssl_, sni_ctx) != 1)
+        return SSL_TLSEXT_ERR_NOACK;
+      p->sni_context_from_store_ = true;
+      return SSL_TLSEXT_ERR_OK;
+    }
+  }
+
   if (!object->Get(env->context(), env->sni_context_string()).ToLocal(&ctx))
     return SSL_TLSEXT_ERR_NOACK;
 
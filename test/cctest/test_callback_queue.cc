@@ -0,0 +1,129 @@
+#include "callback_queue-inl.h"
+#include "gtest/gtest.h"
+#include "uv.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using node::CallbackFlags::kRefed;
+
+// The argument is the next sequence number that is expected from each
+// producer thread.
+using TestQueue = node::CallbackQueue<void, std::vector<int>*>;
+
+TEST(CallbackQueueTest, PushAndShift) {
+  TestQueue queue;
+  std::vector<int> next { 0 };
+  for (int i = 0; i < 3; i++) {
+    queue.Push(queue.CreateCallback([i](std::vector<int>* next) {
+      EXPECT_EQ((*next)[0]++, i);
+    }, kRefed));
+  }
+  EXPECT_EQ(queue.size(), 3u);
+  while (auto head = queue.Shift())
+    head->Call(&next);
+  EXPECT_EQ(queue.size(), 0u);
+  EXPECT_EQ(next[0], 3);
+}
+
+TEST(CallbackQueueTest, ThreadsafeOrder) {
+  TestQueue queue;
+  std::vector<int> next { 0 };
+  EXPECT_TRUE(queue.PushThreadsafe(queue.CreateCallback(
+      [](std::vector<int>* next) { EXPECT_EQ((*next)[0]++, 0); }, kRefed)));
+  EXPECT_FALSE(queue.PushThreadsafe(queue.CreateCallback(
+      [](std::vector<int>* next) { EXPECT_EQ((*next)[0]++, 1); }, kRefed)));
+  EXPECT_EQ(queue.size(), 2u);
+
+  // Entries added through Push() stay in front of those that are moved over.
+  TestQueue taken;
+  taken.Push(taken.CreateCallback(
+      [](std::vector<int>* next) { EXPECT_EQ((*next)[0]++, -1); }, kRefed));
+  next[0] = -1;
+  taken.ConcatMoveThreadsafe(std::move(queue));
+  EXPECT_EQ(queue.size(), 0u);
+  EXPECT_EQ(taken.size(), 3u);
+  while (auto head = taken.Shift())
+    head->Call(&next);
+  EXPECT_EQ(next[0], 2);
+
+  // Once the list has been taken, the next push needs to notify again.
+  EXPECT_TRUE(queue.PushThreadsafe(queue.CreateCallback(
+      [](std::vector<int>* next) {}, kRefed)));
+}
+
+TEST(CallbackQueueTest, ThreadsafeEntriesAreFreed) {
+  auto resource = std::make_shared<int>(0);
+  {
+    TestQueue queue;
+    for (int i = 0; i < 3; i++) {
+      queue.PushThreadsafe(queue.CreateCallback(
+          [resource](std::vector<int>* next) {}, kRefed));
+    }
+    EXPECT_EQ(resource.use_count(), 4);
+  }
+  EXPECT_EQ(resource.use_count(), 1);
+}
+
+namespace {
+
+constexpr int kProducers = 8;
+constexpr int kEntriesPerProducer = 20000;
+
+struct StressTestData {
+  TestQueue* queue;
+  int id;
+  std::atomic<int>* notifications;
+};
+
+void ProduceEntries(void* arg) {
+  StressTestData* data = static_cast<StressTestData*>(arg);
+  const int id = data->id;
+  for (int seq = 0; seq < kEntriesPerProducer; seq++) {
+    auto callback = data->queue->CreateCallback(
+        [id, seq](std::vector<int>* next) {
+          EXPECT_EQ((*next)[id]++, seq);
+        }, kRefed);
+    if (data->queue->PushThreadsafe(std::move(callback)))
+      (*data->notifications)++;
+  }
+}
+
+}  // anonymous namespace
+
+TEST(CallbackQueueTest, ThreadsafeStress) {
+  TestQueue queue;
+  std::atomic<int> notifications {0};
+  std::vector<StressTestData> data;
+  for (int i = 0; i < kProducers; i++)
+    data.push_back({ &queue, i, &notifications });
+
+  uv_thread_t threads[kProducers];
+  for (int i = 0; i < kProducers; i++)
+    ASSERT_EQ(uv_thread_create(&threads[i], ProduceEntries, &data[i]), 0);
+
+  // Consume concurrently with the producers, checking that the entries from
+  // each thread arrive in order and that every batch that was picked up was
+  // announced by exactly one notification.
+  std::vector<int> next(kProducers, 0);
+  int consumed = 0;
+  int batches = 0;
+  while (consumed < kProducers * kEntriesPerProducer) {
+    TestQueue batch;
+    batch.ConcatMoveThreadsafe(std::move(queue));
+    if (batch.size() > 0)
+      batches++;
+    while (auto head = batch.Shift()) {
+      head->Call(&next);
+      consumed++;
+    }
+  }
+
+  for (int i = 0; i < kProducers; i++) {
+    uv_thread_join(&threads[i]);
+    EXPECT_EQ(next[i], kEntriesPerProducer);
+  }
+  EXPECT_EQ(queue.size(), 0u);
+  EXPECT_EQ(notifications.load(), batches);
+}
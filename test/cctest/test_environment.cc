@@ -3,7 +3,10 @@
 #include "libplatform/libplatform.h"
 #include "util.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string>
+#include <vector>
 #include "gtest/gtest.h"
 #include "node_test_fixture.h"
 #include <stdio.h>
@@ -591,6 +594,127 @@ TEST_F(EnvironmentTest, SetImmediateMicrotasks) {
   EXPECT_EQ(called, 1);
 }
 
+namespace {
+
+constexpr int kThreadsafeProducers = 4;
+constexpr int kThreadsafeImmediatesPerProducer = 2000;
+constexpr int kThreadsafeImmediates =
+    kThreadsafeProducers * kThreadsafeImmediatesPerProducer;
+
+struct ThreadsafeImmediateData {
+  node::Environment* env;
+  int* called;
+};
+
+}  // anonymous namespace
+
+TEST_F(EnvironmentTest, SetImmediateThreadsafeFromManyThreads) {
+  int called = 0;
+
+  {
+    const v8::HandleScope handle_scope(isolate_);
+    const Argv argv;
+    Env env {handle_scope, argv};
+
+    node::LoadEnvironment(*env,
+                          [&](const node::StartExecutionCallbackInfo& info)
+                              -> v8::MaybeLocal<v8::Value> {
+      return v8::Object::New(isolate_);
+    });
+
+    // Threadsafe immediates do not keep the event loop alive on their own.
+    (*env)->add_refs(1);
+
+    ThreadsafeImmediateData data { *env, &called };
+    uv_thread_t threads[kThreadsafeProducers];
+    for (uv_thread_t& thread : threads) {
+      ASSERT_EQ(uv_thread_create(&thread, [](void* arg) {
+        ThreadsafeImmediateData* data =
+            static_cast<ThreadsafeImmediateData*>(arg);
+        for (int i = 0; i < kThreadsafeImmediatesPerProducer; i++) {
+          int* called = data->called;
+          data->env->SetImmediateThreadsafe([=](node::Environment* env) {
+            // All of these run on the Environment's own thread.
+            if (++*called == kThreadsafeImmediates)
+              env->add_refs(-1);
+          });
+        }
+      }, &data), 0);
+    }
+
+    uv_run(&current_loop, UV_RUN_DEFAULT);
+    for (uv_thread_t& thread : threads)
+      uv_thread_join(&thread);
+  }
+
+  EXPECT_EQ(called, kThreadsafeImmediates);
+}
+
+namespace {
+
+struct ThreadsafeLatencyData {
+  node::Environment* env;
+  int iterations;
+  std::vector<uint64_t> latencies;
+  std::atomic<bool> done { false };
+};
+
+}  // anonymous namespace
+
+// A microbenchmark of the time between calling SetImmediateThreadsafe() on
+// another thread and the callback running on the Environment's thread.
+// Disabled by default; run it using
+// `cctest --gtest_also_run_disabled_tests --gtest_filter=*Latency*`.
+TEST_F(EnvironmentTest, DISABLED_SetImmediateThreadsafeLatency) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+
+  node::LoadEnvironment(*env,
+                        [&](const node::StartExecutionCallbackInfo& info)
+                            -> v8::MaybeLocal<v8::Value> {
+    return v8::Object::New(isolate_);
+  });
+
+  ThreadsafeLatencyData data;
+  data.env = *env;
+  data.iterations = 100000;
+  data.latencies.reserve(data.iterations);
+  (*env)->add_refs(1);
+
+  // Send one callback at a time, and wait for it to have run before sending
+  // the next one, so that every one of them has to wake up the event loop.
+  uv_thread_t thread;
+  ASSERT_EQ(uv_thread_create(&thread, [](void* arg) {
+    ThreadsafeLatencyData* data = static_cast<ThreadsafeLatencyData*>(arg);
+    for (int i = 0; i < data->iterations; i++) {
+      data->done = false;
+      const uint64_t start = uv_hrtime();
+      data->env->SetImmediateThreadsafe([=](node::Environment* env) {
+        data->latencies.push_back(uv_hrtime() - start);
+        if (static_cast<int>(data->latencies.size()) == data->iterations)
+          env->add_refs(-1);
+        data->done = true;
+      });
+      while (!data->done) {}
+    }
+  }, &data), 0);
+
+  uv_run(&current_loop, UV_RUN_DEFAULT);
+  uv_thread_join(&thread);
+
+  std::vector<uint64_t>& latencies = data.latencies;
+  ASSERT_EQ(latencies.size(), static_cast<size_t>(data.iterations));
+  std::sort(latencies.begin(), latencies.end());
+  printf("SetImmediateThreadsafe() latency: min %llu ns, median %llu ns, "
+         "p99 %llu ns\n",
+         static_cast<unsigned long long>(latencies[0]),  // NOLINT
+         static_cast<unsigned long long>(  // NOLINT(runtime/int)
+             latencies[latencies.size() / 2]),
+         static_cast<unsigned long long>(  // NOLINT(runtime/int)
+             latencies[latencies.size() * 99 / 100]));
+}
+
 #ifndef _WIN32  // No SIGINT on Windows.
 TEST_F(NodeZeroIsolateTestFixture, CtrlCWithOnlySafeTerminationTest) {
   // We need to go through the whole setup dance here because we want to
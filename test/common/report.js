@@ -64,6 +64,12 @@ function _validateContent(report, fields = []) {
   if (report.uvthreadResourceUsage)
     sections.push('uvthreadResourceUsage');
 
+  if (report.asyncCallbacks)
+    sections.push('asyncCallbacks');
+
+  if (report.threadpool)
+    sections.push('threadpool');
+
   if (isJavaScriptThreadReport)
     sections.push('javascriptStack', 'javascriptHeap');
 
@@ -245,6 +251,37 @@ function _validateContent(report, fields = []) {
     assert(Number.isSafeInteger(usage.fsActivity.writes));
   }
 
+  // Verify the format of the asyncCallbacks section, if present.
+  if (report.asyncCallbacks) {
+    for (const stats of Object.values(report.asyncCallbacks)) {
+      checkForUnknownFields(stats, ['count', 'durationMs']);
+      assert(Number.isSafeInteger(stats.count));
+      assert(stats.count > 0);
+      assert.strictEqual(typeof stats.durationMs, 'number');
+      assert(stats.durationMs >= 0);
+    }
+  }
+
+  // Verify the format of the threadpool section, if present.
+  if (report.threadpool) {
+    const histogramFields = ['count', 'min', 'max', 'mean', 'p50', 'p99'];
+    for (const stats of Object.values(report.threadpool)) {
+      checkForUnknownFields(stats,
+                            ['queued', 'running', 'waitTimeMs', 'runTimeMs']);
+      assert(Number.isSafeInteger(stats.queued));
+      assert(Number.isSafeInteger(stats.running));
+      for (const histogram of [stats.waitTimeMs, stats.runTimeMs]) {
+        checkForUnknownFields(histogram, histogramFields);
+        assert(Number.isSafeInteger(histogram.count));
+        if (histogram.count > 0) {
+          for (const field of histogramFields)
+            assert.strictEqual(typeof histogram[field], 'number');
+          assert(histogram.min <= histogram.max);
+        }
+      }
+    }
+  }
+
   // Verify the format of the libuv section.
   assert(Array.isArray(report.libuv));
   report.libuv.forEach((resource) => {
@@ -5,21 +5,21 @@ const { AsyncLocalStorage } = require('async_hooks');
 
 const als = new AsyncLocalStorage();
 
-// Make sure _propagate function exists.
-assert.ok(typeof als._propagate === 'function');
-
-// The als instance should be getting removed from the storageList in
-// lib/async_hooks.js when exit(...) is called, therefore when the nested runs
-// are called there should be no copy of the als in the storageList to run the
-// _propagate method on.
-als._propagate = common.mustNotCall('_propagate() should not be called');
+// exit(...) only leaves the store for the duration of the callback, so
+// repeatedly nesting run(...) and exit(...) should neither keep the store
+// around nor lose it for the surrounding code.
 
 const done = common.mustCall();
 
 function run(count) {
   if (count === 0) return done();
-  als.run({}, () => {
-    als.exit(run, --count);
+  const store = {};
+  als.run(store, () => {
+    als.exit(() => {
+      assert.strictEqual(als.getStore(), undefined);
+      run(count - 1);
+    });
+    assert.strictEqual(als.getStore(), store);
   });
 }
 run(100);
@@ -0,0 +1,70 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+// AsyncLocalStorage propagates its stores without enabling async_hooks, and
+// keeps working when user hooks are enabled alongside it.
+
+const assert = require('assert');
+const fs = require('fs');
+const { AsyncLocalStorage, createHook } = require('async_hooks');
+const { internalBinding } = require('internal/test/binding');
+const {
+  async_hook_fields,
+  constants: {
+    kInit,
+    kUsesAsyncContextFrame,
+    kUsesExecutionAsyncResource,
+  },
+} = internalBinding('async_wrap');
+
+const als = new AsyncLocalStorage();
+
+function checkPropagation(store) {
+  const check = common.mustCall(() => {
+    assert.strictEqual(als.getStore(), store);
+  }, 7);
+
+  als.run(store, () => {
+    setTimeout(check, 1);
+    setImmediate(check);
+    process.nextTick(check);
+    queueMicrotask(check);
+    Promise.resolve().then(check);
+    (async () => {
+      await null;
+      check();
+    })();
+    fs.stat(__filename, common.mustSucceed(check));
+  });
+  assert.strictEqual(als.getStore(), undefined);
+}
+
+checkPropagation({ hooks: false });
+assert.strictEqual(async_hook_fields[kInit], 0);
+assert.strictEqual(async_hook_fields[kUsesExecutionAsyncResource], 0);
+assert.strictEqual(async_hook_fields[kUsesAsyncContextFrame], 1);
+
+setImmediate(common.mustCall(() => {
+  const hook = createHook({ init() {} }).enable();
+  checkPropagation({ hooks: true });
+  setTimeout(common.mustCall(() => {
+    hook.disable();
+
+    // Stores that were entered before disable() do not show up again once
+    // the instance is enabled another time.
+    als.run({ disabled: true }, () => {
+      setImmediate(common.mustCall(() => {
+        assert.strictEqual(als.getStore(), undefined);
+        als.enterWith(2);
+        assert.strictEqual(als.getStore(), 2);
+      }));
+      setImmediate(common.mustCall(() => {
+        assert.strictEqual(async_hook_fields[kUsesAsyncContextFrame], 1);
+        assert.strictEqual(als.getStore(), undefined);
+      }));
+      als.disable();
+      assert.strictEqual(async_hook_fields[kUsesAsyncContextFrame], 0);
+    });
+  }), 10);
+}));
@@ -0,0 +1,106 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures = require('../common/fixtures');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+function expected(algorithm, file, options) {
+  return crypto.createHash(algorithm, options)
+    .update(fs.readFileSync(file))
+    .digest();
+}
+
+const small = fixtures.path('sample.png');
+const empty = path.join(tmpdir.path, 'empty');
+fs.writeFileSync(empty, '');
+// Larger than the native read buffer, so that it is read in several chunks
+// or mapped into memory.
+const large = path.join(tmpdir.path, 'large');
+fs.writeFileSync(large, crypto.randomBytes(3 * 1024 * 1024 + 17));
+
+for (const algorithm of ['md5', 'sha1', 'sha256', 'sha512', 'RSA-SHA256']) {
+  for (const file of [small, empty, large]) {
+    crypto.hashFile(algorithm, file, common.mustSucceed((digest) => {
+      assert.deepStrictEqual(digest, expected(algorithm, file));
+    }));
+    crypto.hashFile(algorithm, file, { mmap: true },
+                    common.mustSucceed((digest) => {
+                      assert.deepStrictEqual(digest,
+                                             expected(algorithm, file));
+                    }));
+  }
+}
+
+// A list of files is hashed in parallel and the results keep their order.
+{
+  const files = [large, small, empty, large, small];
+  crypto.hashFile('sha256', files, { encoding: 'hex', concurrency: 2 },
+                  common.mustSucceed((digests) => {
+                    assert.deepStrictEqual(digests, files.map((file) => {
+                      return expected('sha256', file).toString('hex');
+                    }));
+                  }));
+  crypto.hashFile('sha256', [], common.mustSucceed((digests) => {
+    assert.deepStrictEqual(digests, []);
+  }));
+}
+
+// XOF hash functions and Buffer paths.
+crypto.hashFile('shake256', Buffer.from(small), { outputLength: 100 },
+                common.mustSucceed((digest) => {
+                  assert.strictEqual(digest.length, 100);
+                  assert.deepStrictEqual(
+                    digest, expected('shake256', small, { outputLength: 100 }));
+                }));
+if (common.isLinux) {
+  // Buffer paths do not need to be valid UTF-8.
+  const latin1 = Buffer.concat([Buffer.from(path.join(tmpdir.path, 'f')),
+                                Buffer.from([0xe9])]);
+  fs.writeFileSync(latin1, 'hello');
+  crypto.hashFile('sha256', latin1, common.mustSucceed((digest) => {
+    assert.deepStrictEqual(
+      digest, crypto.createHash('sha256').update('hello').digest());
+  }));
+}
+crypto.hashFile('shake128', small, { outputLength: 0 },
+                common.mustSucceed((digest) => {
+                  assert.strictEqual(digest.length, 0);
+                }));
+
+// File system errors are reported like those of the fs module.
+crypto.hashFile('sha256', [small, path.join(tmpdir.path, 'nonexistent')],
+                common.mustCall((err, digests) => {
+                  assert.strictEqual(err.code, 'ENOENT');
+                  assert.strictEqual(err.syscall, 'open');
+                  assert.strictEqual(digests, undefined);
+                }));
+crypto.hashFile('sha256', tmpdir.path, common.mustCall((err) => {
+  assert.strictEqual(err.code, 'EISDIR');
+}));
+
+assert.throws(() => crypto.hashFile('sha256', small), {
+  code: 'ERR_INVALID_CALLBACK'
+});
+assert.throws(() => crypto.hashFile('nope', small, common.mustNotCall()), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST'
+});
+assert.throws(() => {
+  crypto.hashFile('sha256', small, { outputLength: 10 }, common.mustNotCall());
+}, { message: /Digest method not supported/ });
+assert.throws(() => crypto.hashFile('sha256', 1, common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => {
+  crypto.hashFile('sha256', small, { encoding: 'nope' }, common.mustNotCall());
+}, { code: 'ERR_UNKNOWN_ENCODING' });
+assert.throws(() => {
+  crypto.hashFile('sha256', small, { concurrency: 0 }, common.mustNotCall());
+}, { code: 'ERR_OUT_OF_RANGE' });
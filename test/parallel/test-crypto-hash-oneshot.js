@@ -0,0 +1,83 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const inputs = [
+  '',
+  'some data',
+  'üöä 😀',
+  Buffer.from('buffer data'),
+  new Uint8Array([1, 2, 3]),
+  new DataView(new ArrayBuffer(8)),
+];
+
+for (const algorithm of ['md5', 'sha1', 'sha256', 'sha512', 'RSA-SHA256',
+                         'shake128']) {
+  for (const data of inputs) {
+    const h = () => crypto.createHash(algorithm).update(data);
+    assert.strictEqual(crypto.hash(algorithm, data), h().digest('hex'));
+    assert.strictEqual(crypto.hash(algorithm, data, 'base64'),
+                       h().digest('base64'));
+    assert.deepStrictEqual(crypto.hash(algorithm, data, 'buffer'),
+                           h().digest());
+  }
+
+  // The batch variant packs all digests into one buffer.
+  const digests = crypto.hashBatch(algorithm, inputs);
+  const length = crypto.createHash(algorithm).digest().length;
+  assert.strictEqual(digests.length, length * inputs.length);
+  inputs.forEach((data, i) => {
+    assert.deepStrictEqual(digests.subarray(i * length, (i + 1) * length),
+                           crypto.createHash(algorithm).update(data).digest());
+  });
+  assert.deepStrictEqual(crypto.hashBatch(algorithm, []), Buffer.alloc(0));
+}
+
+// Switching between algorithms does not leak state from one call into the
+// next one.
+assert.strictEqual(crypto.hash('sha1', 'abc'),
+                   'a9993e364706816aba3e25717850c26c9cd0d89d');
+assert.strictEqual(crypto.hash('md5', 'abc'),
+                   '900150983cd24f0d6963f7d28e17f72f');
+assert.strictEqual(crypto.hash('sha1', 'abc'),
+                   'a9993e364706816aba3e25717850c26c9cd0d89d');
+
+assert.throws(() => crypto.hash('nope', 'data'), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST'
+});
+assert.throws(() => crypto.hashBatch('nope', []), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST'
+});
+assert.throws(() => crypto.hash(1, 'data'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => crypto.hash('sha1', 1), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => crypto.hash('sha1', 'data', 'nope'), {
+  code: 'ERR_UNKNOWN_ENCODING'
+});
+assert.throws(() => crypto.hashBatch('sha1', 'data'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => crypto.hashBatch('sha1', ['data', 1]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /"data\[1\]"/
+});
+
+{
+  // Every element is read only once, so a getter cannot swap in a different
+  // value after it has been validated.
+  let reads = 0;
+  const data = ['abc'];
+  Object.defineProperty(data, 0, {
+    get() { return reads++ === 0 ? 'abc' : 1; }
+  });
+  assert.deepStrictEqual(crypto.hashBatch('sha1', data),
+                         crypto.hash('sha1', 'abc', 'buffer'));
+  assert.strictEqual(reads, 1);
+}
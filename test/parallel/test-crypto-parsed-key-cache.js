@@ -0,0 +1,86 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Keys passed to crypto functions as PEM or DER input are parsed once and
+// then served from a per-thread cache.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+const { internalBinding } = require('internal/test/binding');
+const { getParsedKeyCacheStats } = internalBinding('crypto');
+
+const rsaPubPem = fixtures.readKey('rsa_public.pem', 'ascii');
+const rsaKeyPem = fixtures.readKey('rsa_private.pem', 'ascii');
+const rsaKeyPemEncrypted = fixtures.readKey('rsa_private_encrypted.pem',
+                                            'ascii');
+
+const fields = new Float64Array(3);
+function stats() {
+  getParsedKeyCacheStats(fields);
+  return { hits: fields[0], misses: fields[1], size: fields[2] };
+}
+
+function delta(fn) {
+  const before = stats();
+  fn();
+  const after = stats();
+  return {
+    hits: after.hits - before.hits,
+    misses: after.misses - before.misses,
+    size: after.size - before.size,
+  };
+}
+
+const data = Buffer.from('some data to sign');
+let signature;
+
+// The first use of a key parses and caches it, later uses hit the cache.
+assert.deepStrictEqual(delta(() => {
+  signature = crypto.sign('sha256', data, rsaKeyPem);
+}), { hits: 0, misses: 1, size: 1 });
+assert.deepStrictEqual(delta(() => {
+  assert.deepStrictEqual(crypto.sign('sha256', data, rsaKeyPem), signature);
+}), { hits: 1, misses: 0, size: 0 });
+
+assert.deepStrictEqual(delta(() => {
+  assert(crypto.verify('sha256', data, rsaPubPem, signature));
+}), { hits: 0, misses: 1, size: 1 });
+assert.deepStrictEqual(delta(() => {
+  assert(crypto.verify('sha256', data, rsaPubPem, signature));
+  const verify = crypto.createVerify('sha256');
+  verify.update(data);
+  assert(verify.verify(rsaPubPem, signature));
+}), { hits: 2, misses: 0, size: 0 });
+
+// The same bytes in a Buffer map to the same entry.
+assert.deepStrictEqual(delta(() => {
+  const encrypted = crypto.publicEncrypt(Buffer.from(rsaPubPem), data);
+  assert.deepStrictEqual(crypto.privateDecrypt(rsaKeyPem, encrypted), data);
+}), { hits: 1, misses: 1, size: 1 });
+
+assert.deepStrictEqual(delta(() => {
+  const key = crypto.createPublicKey(rsaPubPem);
+  assert.strictEqual(key.asymmetricKeyType, 'rsa');
+}), { hits: 1, misses: 0, size: 0 });
+
+// Keys that need a passphrase are never cached.
+assert.deepStrictEqual(delta(() => {
+  for (let i = 0; i < 2; i++) {
+    crypto.sign('sha256', data, {
+      key: rsaKeyPemEncrypted,
+      passphrase: 'password'
+    });
+  }
+}), { hits: 0, misses: 0, size: 0 });
+
+// Failures are not cached either.
+assert.deepStrictEqual(delta(() => {
+  for (let i = 0; i < 2; i++) {
+    assert.throws(() => crypto.createPublicKey('-----BEGIN PUBLIC KEY-----'),
+                  { name: 'Error' });
+  }
+}), { hits: 0, misses: 2, size: 0 });
@@ -0,0 +1,60 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Small synchronous randomBytes() and randomFillSync() calls are served from
+// a per-thread cache of CSPRNG output that is refilled on the threadpool.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const { internalBinding } = require('internal/test/binding');
+const { getEntropyCacheStats } = internalBinding('crypto');
+
+const fields = new Float64Array(3);
+function stats() {
+  getEntropyCacheStats(fields);
+  return { hits: fields[0], misses: fields[1], refills: fields[2] };
+}
+
+const seen = new Set();
+function check(buf) {
+  const hex = buf.toString('hex');
+  assert(!seen.has(hex), `duplicate random bytes ${hex}`);
+  seen.add(hex);
+}
+
+// Every small request either hits the cache or falls back to OpenSSL after
+// scheduling a refill.
+const initial = stats();
+check(crypto.randomBytes(16));
+const after = stats();
+assert.strictEqual(after.hits + after.misses,
+                   initial.hits + initial.misses + 1);
+
+// Requests larger than the cache limit never touch it.
+const before = stats();
+check(crypto.randomBytes(1024));
+assert.deepStrictEqual(stats(), before);
+
+let rounds = 0;
+(function next() {
+  // Spread the requests over several event loop iterations so that refills
+  // can complete in between. Together they need more than one block.
+  for (let i = 0; i < 512; i++) {
+    check(crypto.randomBytes(16));
+    const buf = Buffer.alloc(48);
+    crypto.randomFillSync(buf, 16, 16);
+    assert(buf.slice(0, 16).equals(Buffer.alloc(16)));
+    assert(buf.slice(32).equals(Buffer.alloc(16)));
+    check(buf.slice(16, 32));
+    crypto.randomInt(1000);
+  }
+  if (++rounds < 16)
+    return setTimeout(next, 10);
+
+  const { hits, refills } = stats();
+  assert(hits > initial.hits);
+  assert(refills > initial.refills);
+})();
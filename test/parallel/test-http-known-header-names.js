@@ -0,0 +1,58 @@
+'use strict';
+const common = require('../common');
+
+// Well-known header names are recognized by the HTTP parser regardless of
+// their case. Their raw spelling must still be preserved in rawHeaders, and
+// duplicates must be handled exactly like for other headers.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const server = http.createServer(common.mustCall((req, res) => {
+  assert.deepStrictEqual(req.rawHeaders, [
+    'Host', 'localhost',
+    'CONTENT-TYPE', 'application/json',
+    'content-type', 'text/plain',
+    'Accept', '*/*',
+    'accept', 'text/html',
+    'Cookie', 'a=1',
+    'cookie', 'b=2',
+    'Set-Cookie', 'c=3',
+    'SET-COOKIE', 'd=4',
+    'Connection', 'keep-alive',
+    'X-Custom', 'value',
+    'x-CUSTOM', 'other',
+  ]);
+  assert.deepStrictEqual(req.headers, {
+    'host': 'localhost',
+    'content-type': 'application/json',
+    'accept': '*/*, text/html',
+    'cookie': 'a=1; b=2',
+    'set-cookie': ['c=3', 'd=4'],
+    'connection': 'keep-alive',
+    'x-custom': 'value, other',
+  });
+  res.end();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, () => {
+    client.end('GET / HTTP/1.1\r\n' +
+               'Host: localhost\r\n' +
+               'CONTENT-TYPE: application/json\r\n' +
+               'content-type: text/plain\r\n' +
+               'Accept: */*\r\n' +
+               'accept: text/html\r\n' +
+               'Cookie: a=1\r\n' +
+               'cookie: b=2\r\n' +
+               'Set-Cookie: c=3\r\n' +
+               'SET-COOKIE: d=4\r\n' +
+               'Connection: keep-alive\r\n' +
+               'X-Custom: value  \r\n' +
+               'x-CUSTOM: other\r\n' +
+               '\r\n');
+  });
+  client.on('data', () => {});
+  client.on('end', common.mustCall(() => server.close()));
+}));
@@ -0,0 +1,105 @@
+'use strict';
+require('../common');
+
+// The header lines of outgoing messages, including the Date header, are put
+// together in C++. Check that the result and the errors for invalid headers
+// are the same as they used to be.
+
+const assert = require('assert');
+const http = require('http');
+const { ServerResponse } = http;
+
+function createResponse() {
+  return new ServerResponse({ method: 'GET', httpVersionMajor: 1,
+                              httpVersionMinor: 1 });
+}
+
+{
+  const res = createResponse();
+  const before = Date.now();
+  res.writeHead(200, {
+    'X-Number': 42,
+    'Set-Cookie': ['a=1', 'b=2'],
+    'Cookie': ['c=3', 'd=4'],
+    'X-Empty': '',
+    'Content-Length': 0,
+  });
+  const lines = res._header.split('\r\n');
+  assert.strictEqual(lines[0], 'HTTP/1.1 200 OK');
+  assert.deepStrictEqual(lines.slice(1, 7), [
+    'X-Number: 42',
+    'Set-Cookie: a=1',
+    'Set-Cookie: b=2',
+    'Cookie: c=3; d=4',
+    'X-Empty: ',
+    'Content-Length: 0',
+  ]);
+  const date = lines[7].match(/^Date: (.*)$/)[1];
+  assert.match(date, /^\w{3}, \d{2} \w{3} \d{4} \d{2}:\d{2}:\d{2} GMT$/);
+  assert.strictEqual(new Date(date).toUTCString(), date);
+  const time = Date.parse(date);
+  assert(time >= Math.floor(before / 1000) * 1000 - 1000);
+  assert(time <= Date.now());
+  assert.strictEqual(lines[8], 'Connection: keep-alive');
+}
+
+{
+  // Given Date, Connection and Transfer-Encoding headers are respected
+  // regardless of their case.
+  const res = createResponse();
+  res.setHeader('date', 'Thu, 01 Jan 1970 00:00:00 GMT');
+  res.setHeader('CONNECTION', 'Keep-Alive, Close');
+  res.setHeader('Transfer-Encoding', 'gzip, chunked');
+  res.writeHead(200);
+  const lines = res._header.split('\r\n');
+  assert.strictEqual(lines.filter((line) => /^date:/i.test(line)).length, 1);
+  assert.strictEqual(lines.filter((line) => /^transfer-encoding:/i.test(line))
+                       .length, 1);
+  assert.strictEqual(res._last, true);
+  assert.strictEqual(res.chunkedEncoding, true);
+}
+
+{
+  const res = createResponse();
+  res.sendDate = false;
+  res.writeHead(204, [['X-A', 'b']]);
+  assert.strictEqual(res._header,
+                     'HTTP/1.1 204 No Content\r\nX-A: b\r\n' +
+                     'Connection: keep-alive\r\n\r\n');
+}
+
+assert.throws(() => createResponse().writeHead(200, { 'X-A': 'ok', 'B C': 1 }),
+              { code: 'ERR_INVALID_HTTP_TOKEN' });
+assert.throws(() => createResponse().writeHead(200, ['', 'x']),
+              { code: 'ERR_INVALID_HTTP_TOKEN' });
+assert.throws(() => createResponse().writeHead(200, { 'X-A': undefined }),
+              { code: 'ERR_HTTP_INVALID_HEADER_VALUE' });
+assert.throws(() => createResponse().writeHead(200, { 'X-A': 'a\nb' }),
+              { code: 'ERR_INVALID_CHAR' });
+assert.throws(() => createResponse().writeHead(200, { 'X-A': 'Ā' }),
+              { code: 'ERR_INVALID_CHAR' });
+assert.throws(() => createResponse().writeHead(200, { 'X-é': 'a' }),
+              { code: 'ERR_INVALID_HTTP_TOKEN' });
+assert.throws(() => createResponse().writeHead(200, { 'X-A': Symbol('a') }),
+              { name: 'TypeError' });
+// Names are validated even if there are no values for them, as before.
+assert.throws(() => createResponse().writeHead(200, { 'B C': [] }),
+              { code: 'ERR_INVALID_HTTP_TOKEN' });
+
+{
+  // A value that only looks invalid the first time it is converted to a
+  // string is still rejected, rather than producing a broken header block.
+  let calls = 0;
+  const value = { toString: () => (calls++ === 0 ? 'a\nb' : 'ok') };
+  const res = createResponse();
+  assert.throws(() => res.writeHead(200, { 'X-A': value }),
+                { code: 'ERR_INVALID_CHAR' });
+  assert.strictEqual(res._header, null);
+}
+
+// Latin-1 values are passed through.
+{
+  const res = createResponse();
+  res.writeHead(200, { 'X-A': 'café' });
+  assert(res._header.includes('X-A: café\r\n'));
+}
@@ -0,0 +1,49 @@
+'use strict';
+require('../common');
+
+// The HTTP parser skips over long runs of valid characters in header values
+// and URLs many bytes at a time. Check that invalid characters are still
+// found at every position within and after such a run, and that the values
+// are passed on unchanged.
+
+const assert = require('assert');
+const { HTTPParser } = require('_http_common');
+
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+
+function parse(request) {
+  const parser = new HTTPParser();
+  parser.initialize(HTTPParser.REQUEST, {});
+  let result;
+  parser[kOnHeadersComplete] = (versionMajor, versionMinor, headers, method,
+                                url) => {
+    result = { headers, url };
+  };
+  const ret = parser.execute(Buffer.from(request, 'latin1'));
+  parser.close();
+  return ret instanceof Error ? ret : result;
+}
+
+for (let length = 1; length < 80; length++) {
+  const value = 'a=b; \tcé'.repeat(10).slice(0, length);
+  const path = `/${'x'.repeat(length)}`;
+
+  assert.deepStrictEqual(parse(`GET ${path}?${value.replace(/\s/g, '')}` +
+                               `#${path} HTTP/1.1\r\nCookie: ${value}\r\n\r\n`),
+                         {
+                           headers: ['Cookie', value.trimEnd()],
+                           url: `${path}?${value.replace(/\s/g, '')}#${path}`
+                         });
+
+  for (let i = 0; i < length; i++) {
+    const invalidValue = `${value.slice(0, i)}\x7f${value.slice(i + 1)}`;
+    const request = `GET / HTTP/1.1\r\nCookie: ${invalidValue}\r\n\r\n`;
+    const err = parse(request);
+    assert.strictEqual(err.code, 'HPE_INVALID_HEADER_TOKEN');
+    assert.strictEqual(err.bytesParsed, request.indexOf('\x7f'));
+
+    const invalidPath = `${path.slice(0, i + 1)}\x01${path.slice(i + 2)}`;
+    const urlError = parse(`GET ${invalidPath} HTTP/1.1\r\n\r\n`);
+    assert.strictEqual(urlError.code, 'HPE_INVALID_URL');
+  }
+}
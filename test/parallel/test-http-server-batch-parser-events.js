@@ -0,0 +1,84 @@
+'use strict';
+const common = require('../common');
+
+// With `batchParserEvents`, all requests received in one read are parsed
+// before they are handled. They still need to arrive in order, with their
+// headers and bodies, and Upgrade requests still need to take over the socket.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const server = http.createServer({ batchParserEvents: true });
+const received = [];
+
+server.on('request', common.mustCall((req, res) => {
+  let body = '';
+  req.setEncoding('utf8');
+  req.on('data', (chunk) => body += chunk);
+  req.on('end', common.mustCall(() => {
+    received.push([req.method, req.url, req.headers['x-id'], body]);
+  }));
+  res.end(req.url);
+}, 4));
+
+server.on('upgrade', common.mustCall((req, socket, head) => {
+  assert.strictEqual(req.url, '/upgrade');
+  assert.strictEqual(head.toString(), 'raw data');
+  socket.end('upgraded');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const { port } = server.address();
+  let pending = 2;
+  function done() {
+    if (--pending > 0)
+      return;
+    // The two connections are handled concurrently.
+    received.sort((a, b) => (a[1] < b[1] ? -1 : 1));
+    assert.deepStrictEqual(received, [
+      ['GET', '/1', 'a', ''],
+      ['POST', '/2', 'b', 'hello'],
+      ['POST', '/3', 'c', 'chunked body'],
+      ['GET', '/4', undefined, ''],
+    ]);
+    server.close();
+  }
+
+  const pipelined = net.connect(port, common.mustCall(() => {
+    pipelined.write('GET /1 HTTP/1.1\r\nHost: x\r\nX-Id: a\r\n\r\n' +
+                    'POST /2 HTTP/1.1\r\nHost: x\r\nX-Id: b\r\n' +
+                    'Content-Length: 5\r\n\r\nhello' +
+                    'POST /3 HTTP/1.1\r\nHost: x\r\nX-Id: c\r\n' +
+                    'Connection: close\r\n' +
+                    'Transfer-Encoding: chunked\r\n\r\n' +
+                    '7\r\nchunked\r\n5\r\n body\r\n0\r\n\r\n');
+  }));
+  let response = '';
+  pipelined.setEncoding('utf8');
+  pipelined.on('data', (chunk) => response += chunk);
+  pipelined.on('end', common.mustCall(() => {
+    const bodies = response.split('\r\n\r\n').slice(1)
+                           .map((part) => part.slice(0, 2));
+    assert.deepStrictEqual(bodies, ['/1', '/2', '/3']);
+    done();
+  }));
+
+  const upgrade = net.connect(port, common.mustCall(() => {
+    upgrade.write('GET /4 HTTP/1.1\r\nHost: x\r\n\r\n' +
+                  'GET /upgrade HTTP/1.1\r\nHost: x\r\n' +
+                  'Connection: Upgrade\r\nUpgrade: test\r\n\r\nraw data');
+  }));
+  let upgradeResponse = '';
+  upgrade.setEncoding('utf8');
+  upgrade.on('data', (chunk) => upgradeResponse += chunk);
+  upgrade.on('end', common.mustCall(() => {
+    assert(upgradeResponse.includes('\r\n\r\n/4'));
+    assert(upgradeResponse.endsWith('upgraded'));
+    done();
+  }));
+}));
+
+assert.throws(() => http.createServer({ batchParserEvents: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
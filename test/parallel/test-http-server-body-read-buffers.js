@@ -0,0 +1,46 @@
+'use strict';
+const common = require('../common');
+
+// Large request bodies are passed to JS as slices of the buffers that the
+// socket read into. Chunks that are held on to must stay intact while the
+// connection keeps reading more data into other buffers.
+
+const assert = require('assert');
+const http = require('http');
+
+const body = Buffer.alloc(4 * 1024 * 1024);
+for (let i = 0; i < body.length; i++)
+  body[i] = (i * 7 + (i >> 12)) & 0xff;
+
+const server = http.createServer(common.mustCall((req, res) => {
+  const chunks = [];
+  req.on('data', (chunk) => chunks.push(chunk));
+  req.on('end', common.mustCall(() => {
+    assert(Buffer.concat(chunks).equals(body));
+    res.end('ok');
+  }));
+}, 2));
+
+server.listen(0, common.mustCall(() => {
+  let pending = 2;
+  for (const chunked of [false, true]) {
+    const req = http.request({
+      port: server.address().port,
+      method: 'POST',
+      headers: chunked ? {} : { 'Content-Length': body.length }
+    }, common.mustCall((res) => {
+      res.resume();
+      res.on('end', common.mustCall(() => {
+        if (--pending === 0)
+          server.close();
+      }));
+    }));
+    // Write in pieces of varying size, so that reads split the body at
+    // arbitrary offsets.
+    for (let offset = 0, size = 1; offset < body.length; size *= 3) {
+      req.write(body.slice(offset, offset + size));
+      offset += size;
+    }
+    req.end();
+  }
+}));
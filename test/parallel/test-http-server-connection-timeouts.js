@@ -0,0 +1,56 @@
+'use strict';
+const common = require('../common');
+
+// The keep-alive and headers timeouts of consumed server sockets are tracked
+// by the HTTP parser instead of JS timers. Idle connections still need to be
+// closed, and a client that stops sending in the middle of the headers is
+// noticed even if it never sends anything again.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const kConnections = 20;
+
+{
+  const server = http.createServer(common.mustCall((req, res) => {
+    req.socket.on('timeout', common.mustCall());
+    res.end('ok');
+  }, kConnections));
+  server.keepAliveTimeout = common.platformTimeout(100);
+
+  server.listen(0, common.mustCall(() => {
+    let closed = 0;
+    for (let i = 0; i < kConnections; i++) {
+      const socket = net.connect(server.address().port, () => {
+        socket.write('GET / HTTP/1.1\r\nHost: localhost\r\n\r\n');
+      });
+      let response = '';
+      socket.setEncoding('utf8');
+      socket.on('data', (chunk) => response += chunk);
+      socket.on('close', common.mustCall(() => {
+        assert(response.startsWith('HTTP/1.1 200 OK\r\n'));
+        assert(response.includes('Keep-Alive: timeout='));
+        if (++closed === kConnections)
+          server.close();
+      }));
+    }
+  }));
+}
+
+{
+  const server = http.createServer(common.mustNotCall());
+  server.headersTimeout = common.platformTimeout(100);
+  server.once('timeout', common.mustCall((socket) => {
+    socket.destroy();
+    server.close();
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port, () => {
+      socket.write('GET / HTTP/1.1\r\nHost: localhost\r\n');
+    });
+    socket.on('error', () => {});
+    socket.on('close', common.mustCall());
+  }));
+}
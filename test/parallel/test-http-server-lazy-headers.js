@@ -0,0 +1,138 @@
+'use strict';
+const common = require('../common');
+
+// With `lazyHeaders`, the header strings of a request are only created when
+// they are accessed. Single headers, `headers` and `rawHeaders` still need to
+// look the same as without the option.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+const { MessageChannel } = require('worker_threads');
+
+// The header lines are kept in an ArrayBuffer that user code can reach.
+function headerBlock(req) {
+  const symbol = Object.getOwnPropertySymbols(req)
+    .find((s) => s.description === 'kHeaderBlock');
+  return req[symbol];
+}
+
+const server = http.createServer({ lazyHeaders: true });
+server.maxHeadersCount = 5;
+
+server.on('request', common.mustCall((req, res) => {
+  switch (req.url) {
+    case '/headers':
+      // Single headers are looked up without building `headers`.
+      assert.strictEqual(req.getHeader('X-Dup'), 'a, b');
+      assert.strictEqual(req.getHeader('host'), 'x');
+      assert.strictEqual(req.getHeader('x-ows'), 'value');
+      assert.deepStrictEqual(req.getHeader('Set-Cookie'), ['c=1']);
+      assert.strictEqual(req.getHeader('x-missing'), undefined);
+      // Lines after `maxHeadersCount` are not part of `headers`.
+      assert.strictEqual(req.getHeader('x-dropped'), undefined);
+      assert.throws(() => req.getHeader(1), {
+        code: 'ERR_INVALID_ARG_TYPE'
+      });
+      assert.strictEqual(
+        typeof Object.getOwnPropertyDescriptor(req, 'headers').get, 'function');
+      assert.deepStrictEqual(req.headers, {
+        'host': 'x',
+        'x-dup': 'a, b',
+        'x-ows': 'value',
+        'set-cookie': ['c=1'],
+      });
+      assert.deepStrictEqual(req.rawHeaders, [
+        'Host', 'x',
+        'X-Dup', 'a',
+        'x-dup', 'b',
+        'X-OWS', 'value',
+        'Set-Cookie', 'c=1',
+        'X-Dropped', 'yes',
+      ]);
+      assert.strictEqual(req.getHeader('x-dup'), 'a, b');
+      // Both are plain data properties again after the first access.
+      for (const name of ['headers', 'rawHeaders']) {
+        const desc = Object.getOwnPropertyDescriptor(req, name);
+        assert.strictEqual(desc.writable, true);
+        assert.strictEqual(desc.enumerable, true);
+      }
+      break;
+    case '/raw':
+      assert.strictEqual(req.rawHeaders.length, 12);
+      assert.strictEqual(req.headers['x-dup'], 'a, b');
+      break;
+    case '/tamper': {
+      // Offsets that point outside of the buffer are rejected.
+      const table = new Uint32Array(headerBlock(req));
+      table[1] = 0xffffffff;
+      assert.throws(() => req.headers, { code: 'ERR_INVALID_ARG_VALUE' });
+      assert.deepStrictEqual(req.headers, {});
+      assert.deepStrictEqual(req.rawHeaders, []);
+      break;
+    }
+    case '/detach': {
+      const block = headerBlock(req);
+      new MessageChannel().port1.postMessage(block, [block]);
+      assert.strictEqual(block.byteLength, 0);
+      assert.throws(() => req.rawHeaders, { code: 'ERR_INVALID_ARG_VALUE' });
+      assert.deepStrictEqual(req.headers, {});
+      break;
+    }
+    case '/expect':
+      assert.strictEqual(req.getHeader('expect'), '100-continue');
+      req.headers = { replaced: true };
+      assert.deepStrictEqual(req.headers, { replaced: true });
+      assert.strictEqual(req.getHeader('Replaced'), true);
+      assert.strictEqual(req.rawHeaders.length, 8);
+      break;
+  }
+  req.resume();
+  res.end(req.url);
+}, 5));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port, common.mustCall(() => {
+    const headers = 'Host: x\r\nX-Dup: a\r\nx-dup: b\r\nX-OWS: value \t\r\n' +
+                    'Set-Cookie: c=1\r\nX-Dropped: yes\r\n\r\n';
+    socket.write(`GET /headers HTTP/1.1\r\n${headers}` +
+                 `GET /raw HTTP/1.1\r\n${headers}` +
+                 `GET /tamper HTTP/1.1\r\n${headers}` +
+                 `GET /detach HTTP/1.1\r\n${headers}`);
+    socket.write('POST /expect HTTP/1.1\r\nHost: x\r\n' +
+                 'Expect: 100-continue\r\nContent-Length: 2\r\n' +
+                 'Connection: close\r\n\r\n');
+  }));
+  let response = '';
+  let continued = false;
+  socket.setEncoding('utf8');
+  socket.on('data', (chunk) => {
+    response += chunk;
+    if (!continued && response.includes('HTTP/1.1 100 Continue\r\n\r\n')) {
+      continued = true;
+      socket.write('ok');
+    }
+  });
+  socket.on('end', common.mustCall(() => {
+    assert(response.includes('\r\n\r\n/headers'));
+    assert(response.includes('\r\n\r\n/raw'));
+    assert(response.includes('\r\n\r\n/tamper'));
+    assert(response.includes('\r\n\r\n/detach'));
+    assert(response.endsWith('\r\n\r\n/expect'));
+    server.close();
+  }));
+}));
+
+assert.throws(() => http.createServer({ lazyHeaders: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+// Without the option, `headers` and `rawHeaders` are plain data properties.
+{
+  const msg = new http.IncomingMessage(null);
+  for (const name of ['headers', 'rawHeaders']) {
+    const desc = Object.getOwnPropertyDescriptor(msg, name);
+    assert.strictEqual(desc.writable, true);
+    assert.strictEqual(desc.enumerable, true);
+  }
+}
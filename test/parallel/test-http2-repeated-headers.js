@@ -0,0 +1,62 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Strings for header fields that come from the HPACK dynamic table are
+// reused across streams. Make sure that headers that repeat, change, are
+// evicted from the table or are sensitive are still received correctly.
+
+const assert = require('assert');
+const http2 = require('http2');
+
+const kRequests = 50;
+
+function test(settings, done) {
+  const server = http2.createServer({ settings });
+  server.on('stream', common.mustCall((stream, headers) => {
+    const i = +headers['x-index'];
+    assert.strictEqual(headers['content-type'], 'application/grpc');
+    assert.strictEqual(headers['x-repeated'], 'repeated value');
+    assert.strictEqual(headers['x-large'], 'x'.repeat(i % 2 ? 5000 : 10));
+    assert.strictEqual(headers[`x-name-${i % 5}`], `value-${i % 3}`);
+    assert.strictEqual(headers['x-secret'], `secret-${i % 2}`);
+    assert.deepStrictEqual(headers[http2.sensitiveHeaders], ['x-secret']);
+    stream.respond({ 'x-repeated': 'repeated value', 'x-index': i });
+    stream.end();
+  }, kRequests));
+
+  server.listen(0, common.mustCall(() => {
+    const client = http2.connect(`http://localhost:${server.address().port}`);
+    let pending = kRequests;
+    for (let i = 0; i < kRequests; i++) {
+      const req = client.request({
+        'content-type': 'application/grpc',
+        'x-repeated': 'repeated value',
+        'x-index': i,
+        'x-large': 'x'.repeat(i % 2 ? 5000 : 10),
+        [`x-name-${i % 5}`]: `value-${i % 3}`,
+        'x-secret': `secret-${i % 2}`,
+        [http2.sensitiveHeaders]: ['x-secret'],
+      });
+      req.on('response', common.mustCall((headers) => {
+        assert.strictEqual(headers['x-repeated'], 'repeated value');
+        assert.strictEqual(headers['x-index'], `${i}`);
+      }));
+      req.resume();
+      req.on('end', common.mustCall(() => {
+        if (--pending === 0) {
+          client.close();
+          server.close(done);
+        }
+      }));
+      req.end();
+    }
+  }));
+}
+
+test({}, common.mustCall(() => {
+  // A small table forces entries to be evicted and the cache to start over.
+  test({ headerTableSize: 128 }, common.mustCall());
+}));
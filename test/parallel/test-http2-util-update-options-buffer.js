@@ -11,7 +11,8 @@ if (!common.hasCrypto)
 const { updateOptionsBuffer } = require('internal/http2/util');
 const { internalBinding } = require('internal/test/binding');
 const { optionsBuffer } = internalBinding('http2');
-const { ok, strictEqual } = require('assert');
+const { ok, strictEqual, throws } = require('assert');
+const http2 = require('http2');
 
 const IDX_OPTIONS_MAX_DEFLATE_DYNAMIC_TABLE_SIZE = 0;
 const IDX_OPTIONS_MAX_RESERVED_REMOTE_STREAMS = 1;
@@ -23,7 +24,8 @@ const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
 const IDX_OPTIONS_MAX_SETTINGS = 9;
-const IDX_OPTIONS_FLAGS = 10;
+const IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE = 10;
+const IDX_OPTIONS_FLAGS = 11;
 
 {
   updateOptionsBuffer({
@@ -37,6 +39,8 @@ const IDX_OPTIONS_FLAGS = 10;
     maxOutstandingSettings: 8,
     maxSessionMemory: 9,
     maxSettings: 10,
+    windowAutoTuning: true,
+    maxAutoTunedWindowSize: 11,
   });
 
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_DEFLATE_DYNAMIC_TABLE_SIZE], 1);
@@ -49,6 +53,7 @@ const IDX_OPTIONS_FLAGS = 10;
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS], 8);
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_SESSION_MEMORY], 9);
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_SETTINGS], 10);
+  strictEqual(optionsBuffer[IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE], 11);
 
   const flags = optionsBuffer[IDX_OPTIONS_FLAGS];
 
@@ -61,6 +66,7 @@ const IDX_OPTIONS_FLAGS = 10;
   ok(flags & (1 << IDX_OPTIONS_MAX_OUTSTANDING_PINGS));
   ok(flags & (1 << IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS));
   ok(flags & (1 << IDX_OPTIONS_MAX_SETTINGS));
+  ok(flags & (1 << IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE));
 }
 
 {
@@ -93,4 +99,32 @@ const IDX_OPTIONS_FLAGS = 10;
 
   ok(!(flags & (1 << IDX_OPTIONS_MAX_SEND_HEADER_BLOCK_LENGTH)));
   ok(!(flags & (1 << IDX_OPTIONS_MAX_OUTSTANDING_PINGS)));
+  ok(!(flags & (1 << IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE)));
+}
+
+{
+  // maxAutoTunedWindowSize is only used if windowAutoTuning is enabled, and
+  // has a default.
+  updateOptionsBuffer({ maxAutoTunedWindowSize: 1024 });
+  ok(!(optionsBuffer[IDX_OPTIONS_FLAGS] &
+       (1 << IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE)));
+
+  updateOptionsBuffer({ windowAutoTuning: true });
+  ok(optionsBuffer[IDX_OPTIONS_FLAGS] &
+     (1 << IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE));
+  strictEqual(optionsBuffer[IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE],
+              16 * 1024 * 1024);
+
+  // Valid values are passed through as they are.
+  updateOptionsBuffer({ windowAutoTuning: true,
+                        maxAutoTunedWindowSize: 2 ** 31 - 1 });
+  strictEqual(optionsBuffer[IDX_OPTIONS_MAX_AUTO_TUNED_WINDOW_SIZE],
+              2 ** 31 - 1);
+
+  // Values that do not fit are rejected when the options are validated,
+  // before they reach updateOptionsBuffer().
+  throws(() => http2.createServer({ windowAutoTuning: true,
+                                    maxAutoTunedWindowSize: 2 ** 32 }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
 }
@@ -0,0 +1,84 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With `windowAutoTuning`, the receive windows of a session grow with the
+// amount of data received during the round trip of internal PING frames.
+// Those PINGs must not be mistaken for user PINGs, and the decisions are
+// recorded in the Http2Session performance entry.
+
+const assert = require('assert');
+const http2 = require('http2');
+const { PerformanceObserver } = require('perf_hooks');
+
+const kMaxWindowSize = 1024 * 1024;
+const body = Buffer.alloc(8 * 1024 * 1024, 'a');
+
+const obs = new PerformanceObserver(common.mustCallAtLeast((items) => {
+  for (const entry of items.getEntries()) {
+    if (entry.name !== 'Http2Session')
+      continue;
+    assert.strictEqual(typeof entry.windowSizeUpdates, 'number');
+    assert.strictEqual(typeof entry.autoTunedWindowSize, 'number');
+    if (entry.type === 'server') {
+      assert.strictEqual(entry.windowSizeUpdates, 0);
+      assert.strictEqual(entry.autoTunedWindowSize, 0);
+    } else if (entry.windowSizeUpdates > 0) {
+      assert(entry.autoTunedWindowSize > 65535);
+      assert(entry.autoTunedWindowSize <= kMaxWindowSize);
+    } else {
+      assert.strictEqual(entry.autoTunedWindowSize, 0);
+    }
+  }
+}));
+obs.observe({ entryTypes: ['http2'] });
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream) => {
+  stream.respond();
+  stream.end(body);
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`, {
+    windowAutoTuning: true,
+    maxAutoTunedWindowSize: kMaxWindowSize,
+  });
+  const req = client.request();
+  let received = 0;
+  req.on('data', (chunk) => {
+    if (received === 0) {
+      client.ping(Buffer.from('userping'), common.mustSucceed((d, payload) => {
+        assert.strictEqual(payload.toString(), 'userping');
+      }));
+    }
+    received += chunk.length;
+  });
+  req.on('end', common.mustCall(() => {
+    assert.strictEqual(received, body.length);
+    // The connection window grew while the body was transferred, but the
+    // advertised settings are not touched.
+    const { effectiveLocalWindowSize } = client.state;
+    assert(effectiveLocalWindowSize > 65535, `${effectiveLocalWindowSize}`);
+    assert(effectiveLocalWindowSize <= kMaxWindowSize);
+    assert.strictEqual(client.localSettings.initialWindowSize, 65535);
+    client.close();
+    server.close();
+  }));
+  req.end();
+}));
+
+for (const maxAutoTunedWindowSize of [1.5, 65534, 2 ** 31, -1, NaN]) {
+  assert.throws(() => http2.connect('http://localhost:1', {
+    windowAutoTuning: true,
+    maxAutoTunedWindowSize,
+  }), { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => http2.createServer({ maxAutoTunedWindowSize }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+assert.throws(() => http2.connect('http://localhost:1', {
+  maxAutoTunedWindowSize: '65535',
+}), { code: 'ERR_INVALID_ARG_TYPE' });
@@ -0,0 +1,83 @@
+'use strict';
+const common = require('../common');
+
+// Check that perf_hooks.monitorAsyncCallbacks() accounts for the time spent
+// in callbacks by async resource type.
+
+const assert = require('assert');
+const fs = require('fs');
+const { monitorAsyncCallbacks } = require('perf_hooks');
+const { validateContent } = require('../common/report');
+
+function busyWait(ms) {
+  const end = Date.now() + ms;
+  while (Date.now() < end);
+}
+
+{
+  // Reports only include the section while tracking is enabled.
+  assert.strictEqual(process.report.getReport().asyncCallbacks, undefined);
+
+  const monitor = monitorAsyncCallbacks();
+  assert.deepStrictEqual(monitor.usage(), {});
+  assert.strictEqual(monitor.disable(), false);
+  assert.strictEqual(monitor.enable(), true);
+  assert.strictEqual(monitor.enable(), false);
+
+  // Nothing is accounted for while the monitor is disabled.
+  const idle = monitorAsyncCallbacks();
+
+  setTimeout(common.mustCall(() => {
+    busyWait(20);
+    setImmediate(common.mustCall(() => {
+      fs.stat(__filename, common.mustCall(() => {
+        busyWait(20);
+        process.nextTick(() => busyWait(10));
+        setImmediate(common.mustCall(check));
+      }));
+    }));
+  }), 1);
+
+  function check() {
+    const usage = monitor.usage();
+    assert.strictEqual(usage.Timeout.count, 1);
+    assert(usage.Timeout.duration >= 20, `${usage.Timeout.duration}`);
+    assert.strictEqual(usage.Immediate.count, 2);
+    assert.strictEqual(usage.FSREQCALLBACK.count, 1);
+    // The nextTick callback counts towards the callback that scheduled it.
+    assert(usage.FSREQCALLBACK.duration >= 30,
+           `${usage.FSREQCALLBACK.duration}`);
+    // The time spent in the fs callback is not included for the immediate
+    // that was running while it was scheduled.
+    assert(usage.Immediate.duration < usage.FSREQCALLBACK.duration);
+    assert.deepStrictEqual(idle.usage(), {});
+
+    const report = process.report.getReport();
+    validateContent(report);
+    assert(report.asyncCallbacks.FSREQCALLBACK.count >= 1);
+    assert(report.asyncCallbacks.Timeout.durationMs >= 20);
+
+    // The values do not change anymore once the monitor is disabled.
+    assert.strictEqual(monitor.disable(), true);
+    assert.strictEqual(process.report.getReport().asyncCallbacks, undefined);
+    const final = monitor.usage();
+    setImmediate(common.mustCall(() => {
+      assert.deepStrictEqual(monitor.usage(), final);
+      monitor.reset();
+      assert.deepStrictEqual(monitor.usage(), {});
+      testResetWhileEnabled();
+    }));
+  }
+}
+
+function testResetWhileEnabled() {
+  const monitor = monitorAsyncCallbacks();
+  monitor.enable();
+  setImmediate(common.mustCall(() => {
+    setImmediate(common.mustCall(() => {
+      assert.strictEqual(monitor.usage().Immediate.count, 1);
+      assert.strictEqual(monitor.disable(), true);
+    }));
+    monitor.reset();
+  }));
+}
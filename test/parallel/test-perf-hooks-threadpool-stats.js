@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+
+// Check that perf_hooks.getThreadpoolStats() reports the work that was
+// submitted to the threadpool, and that reports include it.
+
+const assert = require('assert');
+const zlib = require('zlib');
+const { getThreadpoolStats } = require('perf_hooks');
+const { validateContent } = require('../common/report');
+
+const histogramFields = ['count', 'max', 'mean', 'min', 'p50', 'p99', 'stddev'];
+
+// Kinds of work that were never submitted are left out.
+assert.deepStrictEqual(getThreadpoolStats(), {});
+
+const input = Buffer.alloc(1024 * 1024, 'x');
+zlib.deflate(input, common.mustSucceed(() => {
+  const stats = getThreadpoolStats();
+  assert.strictEqual(stats.napi, undefined);
+  assert.strictEqual(stats.blob, undefined);
+
+  const { queued, running, waitTime, runTime } = stats.zlib;
+  assert.strictEqual(queued, 0);
+  assert.strictEqual(running, 0);
+  for (const histogram of [waitTime, runTime]) {
+    // The histograms are plain copies of the data.
+    assert.deepStrictEqual(Object.keys(histogram).sort(), histogramFields);
+    assert(histogram.count > 0);
+    assert(histogram.min <= histogram.max);
+  }
+  assert(runTime.max > 0);
+
+  const report = process.report.getReport();
+  validateContent(report);
+  assert.strictEqual(report.threadpool.zlib.runTimeMs.count, runTime.count);
+  assert.strictEqual(report.threadpool.zlib.waitTimeMs.count,
+                     report.threadpool.zlib.runTimeMs.count);
+
+  const { count } = runTime;
+  zlib.deflate(input, common.mustSucceed(() => {
+    // Copies that were returned earlier do not change.
+    assert(getThreadpoolStats().zlib.runTime.count > count);
+    assert.strictEqual(runTime.count, count);
+  }));
+}));
+
+if (common.hasCrypto) {
+  const { pbkdf2 } = require('crypto');
+  pbkdf2('secret', 'salt', 1000, 64, 'sha512', common.mustSucceed(() => {
+    const { crypto } = getThreadpoolStats();
+    assert.strictEqual(crypto.queued + crypto.running, 0);
+    assert.strictEqual(crypto.runTime.count, 1);
+    assert(crypto.runTime.max > 0);
+  }));
+  // The work is in flight until its callback runs.
+  const { crypto } = getThreadpoolStats();
+  assert.strictEqual(crypto.queued + crypto.running, 1);
+}
@@ -0,0 +1,105 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+function loadPEM(n) {
+  return fixtures.readKey(`${n}.pem`);
+}
+
+const store = new tls.SNICertStore({ maxCachedContexts: 1 });
+store.add('a.example.com', {
+  key: loadPEM('agent1-key'),
+  cert: loadPEM('agent1-cert')
+});
+store.add('*.TEST.com', {
+  keyFile: fixtures.path('keys', 'agent3-key.pem'),
+  certFile: fixtures.path('keys', 'agent3-cert.pem')
+});
+store.add('broken.example.com', {
+  keyFile: fixtures.path('keys', 'does-not-exist.pem'),
+  certFile: fixtures.path('keys', 'does-not-exist.pem')
+});
+
+// The SNICallback is only consulted for names that the store does not have
+// a usable entry for.
+const sniCallbackNames = [];
+const server = tls.createServer({
+  key: loadPEM('agent2-key'),
+  cert: loadPEM('agent2-cert'),
+  SNICertStore: store,
+  SNICallback(servername, callback) {
+    sniCallbackNames.push(servername);
+    callback(null, null);
+  }
+});
+
+const tests = [
+  ['a.example.com', 'agent1'],
+  ['b.test.com', 'agent3'],
+  ['B.Test.Com', 'agent3'],
+  ['a.example.com', 'agent1'],
+  ['a.b.test.com', 'agent2'],
+  ['broken.example.com', 'agent2'],
+  ['c.wrong.com', 'agent2'],
+];
+
+server.on('tlsClientError', common.mustNotCall());
+
+server.listen(0, common.mustCall(function next() {
+  const test = tests.shift();
+  if (test === undefined) {
+    // Only one context fits in the cache, so switching between the two
+    // hosts evicted the other host's context twice.
+    assert.deepStrictEqual(store.stats(), {
+      hits: 1,
+      misses: 4,
+      evictions: 2,
+      loadErrors: 1,
+      cachedContexts: 1,
+    });
+    assert.deepStrictEqual(
+      sniCallbackNames,
+      ['a.b.test.com', 'broken.example.com', 'c.wrong.com']);
+    server.close();
+    return;
+  }
+
+  const [servername, expectedCN] = test;
+  const client = tls.connect({
+    port: server.address().port,
+    servername,
+    rejectUnauthorized: false
+  }, common.mustCall(() => {
+    assert.strictEqual(client.getPeerCertificate().subject.CN, expectedCN);
+    client.end();
+  }));
+  client.on('close', common.mustCall(next));
+}));
+
+assert.strictEqual(store.delete('a.example.com'), true);
+assert.strictEqual(store.delete('a.example.com'), false);
+store.add('a.example.com', {
+  key: loadPEM('agent1-key'),
+  cert: loadPEM('agent1-cert')
+});
+
+assert.throws(() => new tls.SNICertStore({ maxCachedContexts: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => store.add('', {}), {
+  code: 'ERR_TLS_REQUIRED_SERVER_NAME'
+});
+assert.throws(() => store.add('x.example.com', { cert: 1, key: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => store.add('x.example.com', { certFile: 'cert.pem' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => tls.createServer({ SNICertStore: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
@@ -0,0 +1,127 @@
+'use strict';
+const common = require('../common');
+
+// broadcastMessage() serializes a message once and delivers it to several
+// MessagePorts and Workers.
+
+const assert = require('assert');
+const {
+  MessageChannel,
+  RingChannel,
+  Worker,
+  broadcastMessage,
+  receiveMessageOnPort,
+} = require('worker_threads');
+
+function channels(count) {
+  return Array.from({ length: count }, () => new MessageChannel());
+}
+
+{
+  const pairs = channels(3);
+  const value = { a: [1, 2, 3], b: 'x'.repeat(1000), c: new Map([[1, 2]]) };
+  broadcastMessage(pairs.map(({ port1 }) => port1), value);
+
+  const received =
+    pairs.map(({ port2 }) => receiveMessageOnPort(port2).message);
+  for (const message of received) {
+    assert.deepStrictEqual(message, value);
+    assert.notStrictEqual(message, value);
+  }
+  assert.notStrictEqual(received[0], received[1]);
+  assert.notStrictEqual(received[0].a, received[1].a);
+  for (const { port1 } of pairs) port1.close();
+}
+
+{
+  // Every receiver gets its own copy of an ArrayBuffer or Uint8Array.
+  for (const value of [new Uint8Array([1, 2, 3]), new ArrayBuffer(8)]) {
+    const pairs = channels(2);
+    broadcastMessage(pairs.map(({ port1 }) => port1), value);
+    const [first, second] =
+      pairs.map(({ port2 }) => receiveMessageOnPort(port2).message);
+    new Uint8Array(first.buffer || first).fill(42);
+    assert.deepStrictEqual(second, value);
+    for (const { port1 } of pairs) port1.close();
+  }
+}
+
+{
+  // SharedArrayBuffers are shared between all receivers, as usual.
+  const pairs = channels(2);
+  const sab = new SharedArrayBuffer(4);
+  broadcastMessage(pairs.map(({ port1 }) => port1), sab);
+  const [first, second] =
+    pairs.map(({ port2 }) => receiveMessageOnPort(port2).message);
+  new Uint8Array(first)[0] = 1;
+  assert.strictEqual(new Uint8Array(second)[0], 1);
+  assert.strictEqual(new Uint8Array(sab)[0], 1);
+  for (const { port1 } of pairs) port1.close();
+}
+
+{
+  // The same goes for Uint8Arrays that are backed by a SharedArrayBuffer.
+  const pairs = channels(2);
+  const u8 = new Uint8Array(new SharedArrayBuffer(4));
+  broadcastMessage(pairs.map(({ port1 }) => port1), u8);
+  const [first, second] =
+    pairs.map(({ port2 }) => receiveMessageOnPort(port2).message);
+  u8[0] = 1;
+  assert.strictEqual(first[0], 1);
+  assert.strictEqual(second[0], 1);
+  for (const { port1 } of pairs) port1.close();
+}
+
+{
+  // Messages with cloned host objects are serialized for each receiver.
+  const { producer, consumer } = new RingChannel();
+  const pairs = channels(2);
+  broadcastMessage(pairs.map(({ port1 }) => port1), { producer });
+  for (const { port1, port2 } of pairs) {
+    const { message } = receiveMessageOnPort(port2);
+    assert.strictEqual(message.producer.write(Buffer.from('x')), true);
+    message.producer.close();
+    port1.close();
+  }
+  assert.strictEqual(consumer.getStats().recordsWritten, 2);
+  producer.close();
+  consumer.close();
+}
+
+{
+  // Closed ports are skipped, and the message is still serialized if there
+  // is nobody to deliver it to.
+  const { port1, port2 } = new MessageChannel();
+  port2.close();
+  broadcastMessage([port1], 'hello');
+  broadcastMessage([], 'hello');
+  assert.throws(() => broadcastMessage([], () => {}), {
+    name: 'DataCloneError'
+  });
+  port1.close();
+}
+
+assert.throws(() => broadcastMessage(new MessageChannel().port1, 1), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => broadcastMessage([{}], 1), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+{
+  const workers = [];
+  for (let i = 0; i < 3; i++) {
+    const w = new Worker(`
+      const { parentPort } = require('worker_threads');
+      parentPort.once('message', (message) => {
+        parentPort.postMessage(message.list.length);
+      });
+    `, { eval: true });
+    w.on('message', common.mustCall((length) => {
+      assert.strictEqual(length, 100);
+      w.terminate();
+    }));
+    workers.push(w);
+  }
+  broadcastMessage(workers, { list: new Array(100).fill({ x: 1 }) });
+}
@@ -0,0 +1,74 @@
+'use strict';
+const common = require('../common');
+
+// With setMessagePortBatchSize(), queued messages are emitted as arrays of
+// up to the given size, in the order in which they were sent.
+
+const assert = require('assert');
+const {
+  MessageChannel,
+  setMessagePortBatchSize,
+} = require('worker_threads');
+
+{
+  const { port1, port2 } = new MessageChannel();
+  setMessagePortBatchSize(port2, 4);
+  const batches = [];
+  const onBatch = common.mustCall((messages) => {
+    batches.push(messages);
+    if (batches.length < 3)
+      return;
+    assert.deepStrictEqual(batches, [
+      [0, 1, 2, 3],
+      [4, 5, 6, 7],
+      [8, 9],
+    ]);
+
+    // Going back to single messages.
+    setMessagePortBatchSize(port2, 0);
+    port2.on('message', common.mustCall((message) => {
+      assert.strictEqual(message, 'single');
+      port2.close();
+    }));
+    port2.off('message', onBatch);
+    port1.postMessage('single');
+  }, 3);
+  port2.on('message', onBatch);
+  for (let i = 0; i < 10; i++)
+    port1.postMessage(i);
+}
+
+{
+  // Many messages, in more than one OnMessage() call.
+  const kMessages = 2500;
+  const kBatchSize = 64;
+  const { port1, port2 } = new MessageChannel();
+  setMessagePortBatchSize(port2, kBatchSize);
+  const received = [];
+  port2.onmessage = common.mustCallAtLeast(({ data }) => {
+    assert(Array.isArray(data));
+    assert(data.length >= 1 && data.length <= kBatchSize);
+    received.push(...data);
+    if (received.length === kMessages) {
+      assert.deepStrictEqual(received, [...Array(kMessages).keys()]);
+      port2.close();
+    }
+  });
+  for (let i = 0; i < kMessages; i++)
+    port1.postMessage(i);
+}
+
+{
+  const { port1, port2 } = new MessageChannel();
+  assert.throws(() => setMessagePortBatchSize(port1, -1), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => setMessagePortBatchSize(port1, '1'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => setMessagePortBatchSize({}, 1), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  port1.close();
+  port2.close();
+}
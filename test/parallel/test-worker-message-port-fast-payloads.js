@@ -0,0 +1,97 @@
+'use strict';
+require('../common');
+
+// Primitives, strings and single ArrayBuffers or Uint8Arrays are passed
+// without the general serializer. Check that they arrive just like they
+// would otherwise, and that everything else still takes the general path.
+
+const assert = require('assert');
+const { MessageChannel, receiveMessageOnPort } = require('worker_threads');
+
+const { port1, port2 } = new MessageChannel();
+
+function roundTrip(value, transferList) {
+  port1.postMessage(value, transferList);
+  return receiveMessageOnPort(port2).message;
+}
+
+for (const value of [undefined, null, true, false, 0, -0, 42, -1.5, NaN,
+                     Infinity, 2 ** 53, '', 'hello', 'café', '☃ snow',
+                     'x'.repeat(100000), '\ud800']) {
+  assert(Object.is(roundTrip(value), value));
+}
+
+{
+  const ab = new ArrayBuffer(8);
+  new Uint8Array(ab).set([1, 2, 3, 4, 5, 6, 7, 8]);
+
+  const copy = roundTrip(ab);
+  assert(copy instanceof ArrayBuffer);
+  assert.strictEqual(ab.byteLength, 8);
+  assert.deepStrictEqual(new Uint8Array(copy), new Uint8Array(ab));
+
+  const transferred = roundTrip(ab, [ab]);
+  assert.strictEqual(ab.byteLength, 0);
+  assert.deepStrictEqual([...new Uint8Array(transferred)],
+                         [1, 2, 3, 4, 5, 6, 7, 8]);
+
+  // Detached ArrayBuffers are still rejected.
+  assert.throws(() => port1.postMessage(ab), {
+    name: 'DataCloneError'
+  });
+}
+
+{
+  const u8 = new Uint8Array([1, 2, 3]);
+  const copy = roundTrip(u8);
+  assert.strictEqual(Object.getPrototypeOf(copy), Uint8Array.prototype);
+  assert.deepStrictEqual(copy, u8);
+  assert.notStrictEqual(copy.buffer, u8.buffer);
+
+  const transferred = roundTrip(u8, [u8.buffer]);
+  assert.strictEqual(u8.byteLength, 0);
+  assert.deepStrictEqual([...transferred], [1, 2, 3]);
+
+  // Buffers are received as plain Uint8Arrays.
+  const buf = Buffer.alloc(1024, 'a');
+  const received = roundTrip(buf);
+  assert.strictEqual(Object.getPrototypeOf(received), Uint8Array.prototype);
+  assert.deepStrictEqual(Buffer.from(received), buf);
+}
+
+{
+  // Views of a part of their buffer keep the whole buffer.
+  const ab = new ArrayBuffer(16);
+  const view = roundTrip(new Uint8Array(ab, 4, 8));
+  assert.strictEqual(view.byteOffset, 4);
+  assert.strictEqual(view.length, 8);
+  assert.strictEqual(view.buffer.byteLength, 16);
+
+  // Pooled Buffers cannot be transferred, so they are copied instead.
+  const pooled = Buffer.from('abc');
+  const received = roundTrip(pooled, [pooled.buffer]);
+  assert.strictEqual(pooled.toString(), 'abc');
+  assert.strictEqual(Buffer.from(received).toString(), 'abc');
+}
+
+{
+  // Views of SharedArrayBuffers share their memory with the receiver.
+  const u8 = new Uint8Array(new SharedArrayBuffer(4));
+  const received = roundTrip(u8);
+  assert(received.buffer instanceof SharedArrayBuffer);
+  u8[0] = 42;
+  assert.strictEqual(received[0], 42);
+}
+
+{
+  // Primitives that come with a transfer list still transfer it.
+  const ab = new ArrayBuffer(4);
+  assert.strictEqual(roundTrip(1, [ab]), 1);
+  assert.strictEqual(ab.byteLength, 0);
+
+  assert.deepStrictEqual(roundTrip({ a: [1, 'b'] }), { a: [1, 'b'] });
+  assert.deepStrictEqual(roundTrip(new Uint16Array([1, 2])),
+                         new Uint16Array([1, 2]));
+}
+
+port1.close();
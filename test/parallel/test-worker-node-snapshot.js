@@ -0,0 +1,40 @@
+'use strict';
+const common = require('../common');
+
+// Workers start from the embedded snapshot when there is one, unless
+// --no-node-snapshot is passed. Either way, they should end up with the
+// same kind of context.
+
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+const code = `
+  const { parentPort, MessageChannel } = require('worker_threads');
+  const { port1, port2 } = new MessageChannel();
+  port2.once('message', (message) => {
+    parentPort.postMessage({
+      message,
+      atomicsWake: typeof Atomics.wake,
+      breakIterator: typeof Intl === 'object' ?
+        typeof Intl.v8BreakIterator : 'undefined',
+      postMessage: typeof new MessageChannel().port1.postMessage,
+    });
+    port2.close();
+  });
+  port1.postMessage('hello');
+`;
+
+for (const execArgv of [[], ['--no-node-snapshot']]) {
+  const worker = new Worker(code, { eval: true, execArgv });
+  worker.on('message', common.mustCall((result) => {
+    assert.deepStrictEqual(result, {
+      message: 'hello',
+      atomicsWake: 'undefined',
+      breakIterator: 'undefined',
+      postMessage: 'function',
+    });
+  }));
+  worker.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+  }));
+}
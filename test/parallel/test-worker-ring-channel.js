@@ -0,0 +1,133 @@
+'use strict';
+const common = require('../common');
+
+// RingChannel moves binary records between threads through shared memory.
+// Check ordering, backpressure, the counters and the transfer rules.
+
+const assert = require('assert');
+const {
+  MessageChannel,
+  RingChannel,
+  Worker,
+} = require('worker_threads');
+
+{
+  const { producer, consumer } = new RingChannel({ size: 100 });
+  assert.strictEqual(consumer.read(), undefined);
+
+  assert.strictEqual(producer.write(Buffer.from('abc')), true);
+  assert.strictEqual(producer.write(new Uint16Array([1, 2])), true);
+  assert.strictEqual(producer.write(Buffer.alloc(0)), true);
+  assert.deepStrictEqual(producer.getStats(), {
+    capacity: 128,
+    bytesUsed: 40,
+    bytesWritten: 7,
+    recordsWritten: 3,
+    bytesRead: 0,
+    recordsRead: 0,
+    rejectedWrites: 0,
+  });
+
+  assert.strictEqual(consumer.read().toString(), 'abc');
+  assert.deepStrictEqual(consumer.read(), Buffer.from([1, 0, 2, 0]));
+  assert.deepStrictEqual(consumer.read(), Buffer.alloc(0));
+  assert.strictEqual(consumer.read(), undefined);
+  assert.strictEqual(consumer.getStats().recordsRead, 3);
+  assert.strictEqual(consumer.getStats().bytesUsed, 0);
+
+  // At most half of the ring, minus the record header.
+  assert.throws(() => producer.write(Buffer.alloc(57)), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => producer.write('abc'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+
+  producer.close();
+  consumer.close();
+  assert.strictEqual(producer.write(Buffer.from('x')), false);
+}
+
+{
+  // Records that do not fit before the end of the buffer wrap around, and
+  // writes that do not fit at all fail until the consumer has made room.
+  const { producer, consumer } = new RingChannel({ size: 64 });
+  let next = 0;
+  let expected = 0;
+
+  function writeAll() {
+    while (next < 100) {
+      if (!producer.write(Buffer.alloc(next % 24, next)))
+        break;
+      next++;
+    }
+    assert.strictEqual(producer.writableNeedDrain, next < 100);
+  }
+
+  producer.on('drain', common.mustCallAtLeast(writeAll));
+  consumer.on('readable', common.mustCallAtLeast(() => {
+    let record;
+    while ((record = consumer.read()) !== undefined) {
+      assert.deepStrictEqual(record, Buffer.alloc(expected % 24, expected));
+      expected++;
+    }
+    if (expected === 100) {
+      const stats = consumer.getStats();
+      assert.strictEqual(stats.recordsWritten, 100);
+      assert.strictEqual(stats.recordsRead, 100);
+      assert(stats.rejectedWrites > 0);
+      producer.close();
+      consumer.close(common.mustCall());
+    }
+  }));
+  writeAll();
+}
+
+{
+  // Producers are cloned into other threads, the consumer is transferred.
+  const { producer, consumer } = new RingChannel();
+  const { port1, port2 } = new MessageChannel();
+  const kWorkers = 2;
+  const kRecords = 1000;
+
+  assert.throws(() => port1.postMessage(consumer), {
+    code: 'ERR_MISSING_MESSAGE_PORT_IN_TRANSFER_LIST'
+  });
+  port1.postMessage(consumer, [consumer]);
+  assert.strictEqual(consumer.read(), undefined);
+  assert.strictEqual(consumer.getStats(), undefined);
+
+  port2.once('message', common.mustCall((received) => {
+    port2.close();
+    const counts = new Array(kWorkers).fill(0);
+    received.on('readable', common.mustCallAtLeast(() => {
+      let record;
+      while ((record = received.read()) !== undefined) {
+        const [id, index] = record.toString().split(':').map(Number);
+        assert.strictEqual(index, counts[id]++);
+      }
+      if (counts.every((count) => count === kRecords))
+        received.close();
+    }));
+  }));
+
+  for (let id = 0; id < kWorkers; id++) {
+    const w = new Worker(`
+      const { workerData: { producer, id, kRecords } } =
+        require('worker_threads');
+      let i = 0;
+      function write() {
+        while (i < kRecords && producer.write(Buffer.from(id + ':' + i)))
+          i++;
+        if (i < kRecords)
+          producer.once('drain', write);
+        else
+          producer.close();
+      }
+      producer.ref();
+      write();
+    `, { eval: true, workerData: { producer, id, kRecords } });
+    w.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+  }
+  producer.close();
+}
@@ -0,0 +1,79 @@
+'use strict';
+const common = require('../common');
+
+// Check the `scheduling` option and `worker.cpuUsage()`.
+
+const assert = require('assert');
+const fs = require('fs');
+const { Worker } = require('worker_threads');
+
+for (const scheduling of [
+  null,
+  { cpuAffinity: [] },
+  { cpuAffinity: [-1] },
+  { cpuAffinity: [1.5] },
+  { cpuAffinity: 0 },
+  { niceness: 20 },
+  { niceness: '1' },
+  { policy: 'fifo' },
+  { numaNode: -1 },
+]) {
+  assert.throws(() => new Worker('', { eval: true, scheduling }), {
+    code: /^ERR_(INVALID_ARG_TYPE|INVALID_ARG_VALUE|OUT_OF_RANGE)$/
+  });
+}
+
+if (common.isLinux) {
+  // The thread applies the settings to itself before running any code.
+  // Pick a CPU that this process is allowed to run on.
+  const status = fs.readFileSync('/proc/self/status', 'latin1');
+  const cpu = +status.match(/^Cpus_allowed_list:\s*(\d+)/m)[1];
+  const w = new Worker(`
+    const { parentPort } = require('worker_threads');
+    const status = require('fs').readFileSync('/proc/thread-self/status',
+                                              'latin1');
+    parentPort.postMessage(status.match(/^Cpus_allowed_list:\\s*(.*)$/m)[1]);
+  `, {
+    eval: true,
+    scheduling: { cpuAffinity: [cpu], niceness: 5, policy: 'batch' }
+  });
+  w.on('message', common.mustCall((cpus) => {
+    assert.strictEqual(cpus, `${cpu}`);
+  }));
+  w.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+}
+
+// worker.cpuUsage() is not supported on other platforms.
+if (common.isLinux || common.isOSX || common.isWindows) {
+  // Keep the thread busy for a while, so that its CPU time shows up.
+  const w = new Worker(`
+    const end = Date.now() + 200;
+    while (Date.now() < end);
+  `, { eval: true });
+
+  const initial = w.cpuUsage();
+  assert.strictEqual(typeof initial.user, 'number');
+  assert.strictEqual(typeof initial.system, 'number');
+  // The previous value is validated like for process.cpuUsage().
+  assert.throws(() => w.cpuUsage(1), { code: 'ERR_INVALID_ARG_TYPE' });
+  assert.throws(() => w.cpuUsage({}), { code: 'ERR_INVALID_ARG_TYPE' });
+  assert.throws(() => w.cpuUsage({ user: 0, system: '0' }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => w.cpuUsage({ user: -1, system: 0 }), {
+    code: 'ERR_INVALID_OPT_VALUE'
+  });
+  assert.throws(() => w.cpuUsage({ user: 0, system: NaN }), {
+    code: 'ERR_INVALID_OPT_VALUE'
+  });
+
+  w.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    const usage = w.cpuUsage();
+    assert(usage.user + usage.system > 0);
+    assert(usage.user >= initial.user);
+    // The final value does not change anymore.
+    assert.deepStrictEqual(w.cpuUsage(), usage);
+    assert.deepStrictEqual(w.cpuUsage(usage), { user: 0, system: 0 });
+  }));
+}
@@ -55,6 +55,7 @@ const { getSystemErrorName } = require('util');
     delete providers.SIGINTWATCHDOG;
     delete providers.WORKERHEAPSNAPSHOT;
     delete providers.FIXEDSIZEBLOBCOPY;
+    delete providers.RINGCHANNEL;
 
     const objKeys = Object.keys(providers);
     if (objKeys.length > 0)
@@ -131,6 +132,10 @@ if (common.hasCrypto) { // eslint-disable-line node-core/crypto-check
     testInitialized(this, 'AsyncWrap');
   }));
 
+  crypto.hashFile('sha256', __filename, common.mustCall(function hf() {
+    testInitialized(this, 'AsyncWrap');
+  }));
+
   if (typeof internalBinding('crypto').scrypt === 'function') {
     crypto.scrypt('password', 'salt', 8, common.mustCall(function() {
       testInitialized(this, 'AsyncWrap');